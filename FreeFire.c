@@ -3,21 +3,77 @@
  * Operações: inserir, remover, listar, buscar (sequencial nas duas estruturas
  * e binária apenas no vetor após ordenação). Exibe contadores de comparações
  * para as buscas, destacando diferenças de desempenho.
+ *
+ * Modo lote: "FreeFire --script ops.txt" executa um arquivo de comandos sem
+ * menus nem listagens intermediárias e imprime apenas o resumo final com a
+ * vazão (ops/s). Uma operação por linha, campos separados por ';':
+ *   vetor inserir <nome>;<tipo>;<quantidade>   lista inserir ...
+ *   vetor remover <nome>                        lista remover <nome>
+ *   vetor buscar <nome>                         lista buscar <nome>
+ *   vetor hash <nome>                           lista hash <nome>
+ *   vetor soa <nome>    (busca no layout SoA com filtro SIMD por hash do nome)
+ *   desenrolada inserir|remover|buscar (mesmos campos da lista)
+ *   vetor ordenar                               vetor binaria <nome>
+ *   vetor paralelo [threads]  (merge sort paralelo por nome; padrão: todas as CPUs)
+ *   vetor|torre eytzinger <nome>                (índice em layout BFS, descida sem desvios)
+ *   vetor manter [off]  (inserções/remoções preservam a ordem por nome)
+ *   vetor|lista|torre prefixo <p>               vetor|lista|torre intervalo <de>;<ate>
+ *   vetor|lista|torre radix <nome>              (busca exata na árvore radix dos nomes)
+ *   vetor|lista|torre completar <p>             vetor|lista|torre topk <p>  (maior qtd/prioridade)
+ *   torre inserir <nome>;<tipo>;<prioridade>
+ *   torre ordenar nome|tipo|prioridade          torre binaria <nome>
+ *   torre faixa <tipo>;<prioridade minima>      (índice secundário tipo + prioridade)
+ *   torre mergesort nome|tipo|prioridade        torre contagem prioridade|tipo
+ *   torre paralelo nome|tipo|prioridade[;threads]  (merge sort com pthreads; padrão: todas as CPUs)
+ *   vetor|lista|torre importar <arquivo.csv>    vetor|lista|torre exportar <arquivo.csv>
+ *   vetor|lista|torre lote <arquivo>            (um nome por linha, resolvidos de uma vez)
+ * Linhas vazias ou iniciadas por '#' são ignoradas.
+ *
+ * Benchmark: "FreeFire --bench [saida.csv|saida.json] [n maximo] [limite quadratico]"
+ * gera inventários sintéticos (semente fixa) de 10^2 até 10^6 itens e mede
+ * buscas e ordenações em entradas ordenada, reversa e aleatória.
+ *
+ * Estresse: "FreeFire --stress [leitores] [segundos] [itens]" mede a vazão de
+ * buscas de várias threads leitoras sozinhas e com um escritor contínuo.
+ *
+ * Diário: "FreeFire --journal arquivo [--script ops.txt]" recupera vetor,
+ * lista e torre do diário ao iniciar e registra nele cada inserção/remoção
+ * (fsync em lotes); ordenações e o modo "manter ordenado" compactam o diário
+ * em um snapshot, o que a opção 12 do menu também faz sob demanda.
+ *
+ * Compilação: gcc -O2 -pthread FreeFire.c -o FreeFire
  */
 
+#define _GNU_SOURCE /* pthread_rwlockattr_setkind_np (preferência ao escritor) */
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
 #include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
-#define CAPACIDADE_MAXIMA 50
+#define CAPACIDADE_INICIAL 16
 #define TAM_NOME 30
 #define TAM_TIPO 20
-#define MAX_COMPONENTES 20
+
+/* Tipos são internados numa tabela global e os registros guardam só o id. */
+typedef unsigned short IdTipo;
+#define MAX_TIPOS 65535
 
 typedef struct {
 	char nome[TAM_NOME];
-	char tipo[TAM_TIPO];
+	IdTipo tipo;
 	int quantidade;
 } Item;
 
@@ -26,66 +82,674 @@ typedef struct No {
 	struct No *proximo;
 } No;
 
+/* Índice hash de endereçamento aberto (sondagem linear) sobre Item.nome. */
+#define HASH_VAZIO 0
+#define HASH_OCUPADO 1
+#define HASH_REMOVIDO 2
+#define HASH_CAPACIDADE_INICIAL 64
+
+typedef struct {
+	char nome[TAM_NOME];
+	unsigned int hash;
+	unsigned char estado;
+	int posicao; /* índice no vetor (-1 quando indexa a lista) */
+	No *no;      /* nó da lista (NULL quando indexa o vetor) */
+} EntradaHash;
+
+typedef struct {
+	EntradaHash *entradas;
+	int capacidade; /* sempre potência de 2 */
+	int ocupados;
+	int removidos;
+} IndiceHash;
+
+/* Árvore radix (trie com compressão de caminho) sobre os nomes, para
+ * autocompletar. Nós num vetor único ligados por índice (0 = nenhum; o nó 0
+ * é a raiz, nunca filho nem irmão) e rótulos numa arena de caracteres. */
+typedef struct {
+	int rotulo;          /* deslocamento do rótulo na arena */
+	int peso;            /* quantidade (vetor/lista) ou prioridade (torre) */
+	int filho;           /* primeiro filho */
+	int irmao;           /* próximo irmão, em ordem do primeiro caractere */
+	int ocorrencias;     /* nomes que terminam neste nó (0 = nó interno) */
+	unsigned char tamanho;
+} NoRadix;
+
+typedef struct {
+	NoRadix *nos;
+	int totalNos;       /* posições usadas em 'nos', incluindo as livres */
+	int capacidadeNos;
+	int livres;         /* lista de nós livres encadeada por 'irmao' */
+	int nosLivres;
+	char *arena;
+	int usadosArena;
+	int capacidadeArena;
+	int arenaMorta;     /* bytes de rótulos abandonados por fusões e remoções */
+	int nomes;          /* nomes distintos guardados */
+} ArvoreRadix;
+
+/* Sugestão de autocompletar: nome reconstruído a partir do caminho. */
+typedef struct {
+	char nome[TAM_NOME];
+	int peso;
+} SugestaoRadix;
+
+#define MAX_SUGESTOES 10
+
+/* Lista desenrolada: ITENS_POR_BLOCO itens contíguos por nó, reduzindo
+ * saltos de ponteiro (e faltas de cache) na busca sequencial. */
+#define ITENS_POR_BLOCO 16
+
+typedef struct NoDesenrolado {
+	int usados;
+	struct NoDesenrolado *proximo;
+	Item itens[ITENS_POR_BLOCO];
+} NoDesenrolado;
+
+typedef struct {
+	NoDesenrolado *inicio;
+	NoDesenrolado *fim;
+	int tamanho;
+	int nos;
+} ListaDesenrolada;
+
 /* Estrutura para os componentes da torre de fuga */
 typedef struct {
 	char nome[TAM_NOME];
-	char tipo[TAM_TIPO];
+	IdTipo tipo;
 	int prioridade;
 } Componente;
 
+/* Diário de operações (definido adiante); estruturas sem diário têm NULL. */
+typedef struct Diario Diario;
+
+/* Cópia dos nomes ordenados em layout de Eytzinger (ordem de busca em
+ * largura): o nó k tem filhos 2k e 2k+1, e cada par de irmãos ocupa uma
+ * única linha de cache de 64 bytes. Somente leitura; refeito quando a origem muda. */
+#define TAM_NO_EYTZINGER 32 /* TAM_NOME arredondado: dois nomes por linha de cache */
+
+typedef struct {
+	char (*nomes)[TAM_NO_EYTZINGER]; /* nomes[1..total]; nomes[0] não é usado */
+	int *posicoes;                   /* posição de cada nó no vetor de origem */
+	int total;
+	int capacidade;
+	unsigned long versao;
+	int sincronizado;
+} IndiceEytzinger;
+
+/* Vetores no heap com crescimento geométrico (dobra a capacidade quando enche). */
+typedef struct {
+	Item *itens;
+	int tamanho;
+	int capacidade;
+	IndiceHash indice;
+	ArvoreRadix radix;
+	unsigned long versao; /* incrementada a cada alteração; invalida cópias derivadas */
+	int manterOrdenado;   /* inserções/remoções preservam a ordem por nome */
+	long reordenacoesEvitadas;
+	IndiceEytzinger eytzinger; /* válido enquanto eytzinger.versao == versao */
+	Diario *diario;
+} VetorItens;
+
+/* Layout alternativo SoA da mochila: nomes, tipos e quantidades em vetores
+ * separados, mais um vetor compacto com o hash de 32 bits de cada nome para
+ * a varredura vetorizada. Reconstruído quando a versão do vetor muda. */
+typedef struct {
+	unsigned int *assinaturas;
+	char (*nomes)[TAM_NOME];
+	IdTipo *tipos;
+	int *quantidades;
+	int tamanho;
+	int capacidade;
+	unsigned long versao;
+	int sincronizado;
+} MochilaSoA;
+
+/* Pool de nós: blocos contíguos (32, 64, ... até 4096 nós) e lista de nós
+ * livres reciclados pelas remoções; liberado inteiro em O(blocos). */
+#define NOS_BLOCO_INICIAL 32
+#define NOS_BLOCO_MAXIMO 4096
+
+typedef struct BlocoNos {
+	struct BlocoNos *proximo;
+	int capacidade;
+	No nos[];
+} BlocoNos;
+
+typedef struct {
+	BlocoNos *blocos;
+	int usadosNoBloco;
+	No *livres;
+	long blocosAlocados;
+	long nosEntregues;
+	long nosReciclados;
+} PoolNos;
+
+/* Lista encadeada com ponteiro para o fim (append O(1)), tamanho mantido
+ * e índice hash para busca e remoção sem percorrer os nós. */
+typedef struct {
+	No *inicio;
+	No *fim;
+	int tamanho;
+	IndiceHash indice;
+	ArvoreRadix radix;
+	PoolNos pool;
+	Diario *diario;
+} ListaItens;
+
+/* Critérios de ordenação da torre; cada um pode ter sua própria visão indireta. */
+typedef enum {
+	CRITERIO_NOME,
+	CRITERIO_TIPO,
+	CRITERIO_PRIORIDADE,
+	CRITERIO_PRIORIDADE_NOME, /* prioridade decrescente, depois nome */
+	CRITERIO_TIPO_PRIORIDADE, /* tipo, depois prioridade decrescente */
+	TOTAL_CRITERIOS
+} Criterio;
+
+/* visoes[c] é uma permutação de índices de 'itens' ordenada pelo critério c:
+ * várias ordens convivem sem mover os componentes (4 bytes por troca, não o struct). */
+typedef struct {
+	Componente *itens;
+	int total;
+	int capacidade;
+	int *visoes[TOTAL_CRITERIOS];
+	int visaoValida[TOTAL_CRITERIOS];
+	ArvoreRadix radix; /* nomes repetidos somam ocorrências; peso = maior prioridade */
+	IndiceEytzinger eytzinger; /* invalidado junto com as visões */
+	Diario *diario;
+} VetorComponentes;
+
+/* Texto de cada tipo guardado uma vez; 'posto' é a posição alfabética do id,
+ * de modo que ordenar por tipo compara inteiros em vez de strings. */
+typedef struct {
+	char (*nomes)[TAM_TIPO];
+	IdTipo *posto;
+	int *hash;          /* ids por posição (-1 = vazio), sondagem linear */
+	int capacidadeHash; /* potência de 2 */
+	int total;
+	int capacidade;
+} TabelaTipos;
+
+/* Consulta por nome: prefixo (de == ate, compara só tamanhoPrefixo
+ * caracteres) ou intervalo fechado [de, ate]. */
+typedef struct {
+	const char *de;
+	const char *ate;
+	int porPrefixo;
+	size_t tamanhoPrefixo;
+} FaixaNomes;
+
+#define MAX_FAIXA_EXIBIDA 20
+
+/* Vetor compartilhado entre threads: buscas sob lock de leitura, inserções e
+ * remoções sob lock de escrita. O rwlock é criado com preferência ao escritor. */
+typedef struct {
+	VetorItens vetor;
+	int ordenado;
+	_Atomic int encerrar; /* fim do teste de estresse; lido fora da trava */
+	pthread_rwlock_t trava;
+} InventarioConcorrente;
+
+/* Diário de operações (write-ahead log): cada alteração de vetor, lista e
+ * torre vira um registro de tamanho fixo; os registros vão para o disco em
+ * lotes, com um único fsync por lote. */
+#define DIARIO_LOTE 64
+#define DIARIO_COMPACTAR_APOS 2000000 /* registros desde a última compactação */
+
+typedef enum {
+	DIARIO_VETOR_INSERIR = 1,
+	DIARIO_VETOR_REMOVER,
+	DIARIO_LISTA_INSERIR,
+	DIARIO_LISTA_REMOVER,
+	DIARIO_TORRE_INSERIR,
+	DIARIO_TORRE_LIMPAR
+} OperacaoDiario;
+
+typedef struct {
+	unsigned int verificacao; /* FNV-1a dos demais bytes do registro */
+	unsigned char operacao;
+	char nome[TAM_NOME];
+	char tipo[TAM_TIPO];      /* texto: os ids internados valem só nesta execução */
+	int valor;                /* quantidade ou prioridade */
+} RegistroDiario;
+
+struct Diario {
+	int descritor;
+	char caminho[256];
+	RegistroDiario pendentes[DIARIO_LOTE];
+	int totalPendentes;
+	long registrosDesdeCompactacao;
+	long anexados;
+	long long tempoAnexarNs;
+	long long maiorAnexarNs;
+	long lotesGravados;
+	long long tempoLotesNs;
+	long compactacoes;
+	int falhou; /* erro de gravação: alterações seguintes não são registradas */
+};
+
+/* O que a abertura do diário recuperou do disco. */
+typedef struct {
+	int tinhaSnapshot;
+	long registros;
+	long aplicados; /* registros restantes após descartar operações superadas */
+	long bytesDescartados;
+	double segundos;
+} ResultadoDiario;
+
+/* Nomes de uma busca em lote, na ordem em que foram lidos. */
+typedef struct {
+	char (*nomes)[TAM_NOME];
+	int total;
+	int capacidade;
+} LoteNomes;
+
+/* Contadores de uma thread do merge sort paralelo, cada um na sua linha de
+ * cache para as threads não disputarem a mesma linha ao incrementar. */
+#define MAX_THREADS_ORDENACAO 64
+#define TAM_LINHA_CACHE 64
+
+typedef struct {
+	_Alignas(TAM_LINHA_CACHE) long comparacoes;
+	long movimentos;
+	long intercalacoes;
+} ContadoresThread;
+
+typedef struct {
+	int threads;
+	ContadoresThread porThread[MAX_THREADS_ORDENACAO];
+} EstatisticasParalelo;
+
+/* Estatísticas (ns) de uma operação medida uma ou mais vezes. */
+typedef struct {
+	long long minimo;
+	long long mediana;
+	long long p99;
+	int amostras;
+} EstatisticasTempo;
+
+#define MAX_REPETICOES 100000
+
+/* Operação cronometrada por medirRepetido; recebe o contexto de quem mede. */
+typedef void (*OperacaoMedida)(void *contexto);
+
+/* Consulta dos menus medida por medirConsulta: 'executar' roda a consulta
+ * sobre 'estrutura' e grava aqui o resultado; os contadores são zerados
+ * antes de cada repetição. */
+typedef struct ConsultaMedida ConsultaMedida;
+struct ConsultaMedida {
+	void (*executar)(ConsultaMedida *consulta);
+	void *estrutura;
+	const void *chave;  /* nome procurado ou FaixaNomes */
+	int argumento;      /* prioridade mínima ou critério da visão */
+	long contador;      /* comparações ou sondagens da última repetição */
+	long nosVisitados;
+	int resultado;      /* posição (-1: não achou), quantos achou ou sucesso */
+	int inicio;         /* primeira posição da faixa no vetor */
+	const void *achado; /* nó ou item encontrado */
+	const int *indices; /* posições encontradas na torre */
+	const No **nos;     /* saída da faixa da lista (até MAX_FAIXA_EXIBIDA) */
+};
+
 /* Utilidades de entrada: limpam buffer e leem linha com corte do \n. */
 void limparBufferEntrada(void);
 void lerLinha(char *destino, size_t tamanho);
+int lerInteiroCampo(const char *campo, int *valor);
+
+/* Mensagens de erro das operações; suprimidas no modo lote. */
+void avisar(const char *formato, ...);
+double tempoMonotonico(void);
+long long agoraNs(void);
+void resumirAmostras(long long amostras[], int total, EstatisticasTempo *estatisticas);
+void resumirAmostraUnica(EstatisticasTempo *estatisticas, long long amostra);
+EstatisticasTempo medirRepetido(int repeticoes, OperacaoMedida preparo, OperacaoMedida operacao, void *contexto);
+ConsultaMedida novaConsulta(void (*executar)(ConsultaMedida *consulta), void *estrutura, const void *chave, int argumento);
+EstatisticasTempo medirConsulta(ConsultaMedida *consulta);
+void executarBuscaSequencialVetor(ConsultaMedida *consulta);
+void executarBuscaBinariaVetor(ConsultaMedida *consulta);
+void executarBuscaHashVetor(ConsultaMedida *consulta);
+void executarFaixaVetor(ConsultaMedida *consulta);
+void executarBuscaEytzinger(ConsultaMedida *consulta);
+void executarBuscaSequencialLista(ConsultaMedida *consulta);
+void executarBuscaHashLista(ConsultaMedida *consulta);
+void executarFaixaLista(ConsultaMedida *consulta);
+void executarBuscaDesenrolada(ConsultaMedida *consulta);
+void executarBuscaBinariaTorre(ConsultaMedida *consulta);
+void executarOrdenarVisao(ConsultaMedida *consulta);
+void executarConsultaTipoPrioridade(ConsultaMedida *consulta);
+void executarFaixaTorre(ConsultaMedida *consulta);
+void imprimirTempo(const EstatisticasTempo *estatisticas);
+void configurarRepeticoes(void);
+int executarScript(const char *caminho, const char *caminhoDiario);
+int executarBenchmark(const char *caminhoSaida, int tamanhoMaximo, int limiteQuadratico);
+
+/* Snapshot binário versionado de vetor, lista e torre (carga via mmap). */
+int salvarSnapshot(const char *caminho, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome);
+int carregarSnapshot(const char *caminho, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome);
+void menuSnapshot(int carregar, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome);
+
+/* Diário de operações: acrescenta em lotes com fsync, recupera na abertura e compacta em snapshot. */
+int abrirDiario(Diario *diario, const char *caminho, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome, ResultadoDiario *resultado);
+void registrarDiario(Diario *diario, OperacaoDiario operacao, const char *nome, const char *tipo, int valor);
+int descarregarDiario(Diario *diario);
+int compactarDiario(Diario *diario, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome);
+void manterDiario(Diario *diario, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome);
+void fixarOrdemDiario(Diario *diario, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome);
+void fecharDiario(Diario *diario);
+void mostrarResultadoDiario(const char *caminho, const ResultadoDiario *resultado);
+void mostrarEstatisticasDiario(const Diario *diario);
+
+/* Importação/exportação CSV em fluxo, com a mesma validação das inserções. */
+typedef enum {
+	CSV_VETOR = 1,
+	CSV_LISTA,
+	CSV_TORRE
+} DestinoCsv;
+
+typedef struct {
+	long linhas;
+	long aceitas;
+	long rejeitadas;
+	double segundos;
+} ResultadoCsv;
+
+int importarCsv(const char *caminho, DestinoCsv destino, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome, ResultadoCsv *resultado);
+int exportarCsv(const char *caminho, DestinoCsv destino, const VetorItens *mochila, const ListaItens *lista, const VetorComponentes *torre, ResultadoCsv *resultado);
+void mostrarResultadoCsv(const char *operacao, const ResultadoCsv *resultado);
+void menuCsv(int exportar, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome);
+
+/* Busca em lote: intercalação com o inventário ordenado ou sequencial repartida entre threads. */
+int lerLoteNomes(const char *caminho, LoteNomes *lote);
+void liberarLoteNomes(LoteNomes *lote);
+int buscarLoteVetor(const VetorItens *mochila, int ordenado, const LoteNomes *lote, int posicoes[], int threads, long *comparacoes);
+int buscarLoteLista(const ListaItens *lista, const LoteNomes *lote, const No *encontradosPorNome[], int threads, long *comparacoes);
+int buscarLoteTorre(VetorComponentes *torre, const LoteNomes *lote, int posicoes[], long *comparacoes);
+void menuLote(DestinoCsv destino, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, VetorComponentes *torre);
+
+/* Inventário concorrente (rwlock) e teste de estresse de leitores sob escrita. */
+int iniciarInventarioConcorrente(InventarioConcorrente *inventario);
+int inserirConcorrente(InventarioConcorrente *inventario, const char *nome, const char *tipo, int quantidade);
+int removerConcorrente(InventarioConcorrente *inventario, const char *nome);
+int buscarConcorrente(InventarioConcorrente *inventario, const char *nome, int binaria, Item *copia, long *comparacoes);
+void liberarInventarioConcorrente(InventarioConcorrente *inventario);
+int executarEstresse(int totalLeitores, double segundos, int itensIniciais);
+void menuEstresse(void);
 
 int menuEstrutura(void);
 int menuVetor(void);
 int menuLista(void);
 int menuTorreFuga(void);
+int menuListaDesenrolada(void);
+
+/* Gerência de memória dos vetores dinâmicos: reserva, compactação e liberação. */
+int reservarVetor(VetorItens *mochila, int capacidade);
+void compactarVetor(VetorItens *mochila);
+void liberarVetor(VetorItens *mochila);
+int reservarComponentes(VetorComponentes *torre, int capacidade);
+void compactarComponentes(VetorComponentes *torre);
+void liberarComponentes(VetorComponentes *torre);
 
-int inserirItemVetor(Item mochila[], int *tamanho, const char *nome, const char *tipo, int quantidade, int *ordenado);
-int removerItemVetor(Item mochila[], int *tamanho, const char *nome, int *ordenado);
-void listarItensVetor(const Item mochila[], int tamanho);
+int inserirItemVetor(VetorItens *mochila, const char *nome, const char *tipo, int quantidade, int *ordenado);
+int removerItemVetor(VetorItens *mochila, const char *nome, int *ordenado);
+void listarItensVetor(const VetorItens *mochila);
 int buscarSequencialVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes);
-int ordenarVetor(Item mochila[], int tamanho);
+int ordenarVetor(VetorItens *mochila, long *comparacoes);
+int ordenarVetorParalelo(VetorItens *mochila, int threads, long *comparacoes);
+int ordenarVetorParaleloPadrao(VetorItens *mochila, long *comparacoes);
+typedef int (*OrdenacaoVetor)(VetorItens *mochila, long *comparacoes);
+EstatisticasTempo medirOrdenacaoVetor(OrdenacaoVetor ordenar, VetorItens *mochila, long *comparacoes, int *ordenou);
 int buscarBinariaVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes);
+int limiteInferiorVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes);
 
-int inserirItemLista(No **inicio, const char *nome, const char *tipo, int quantidade);
-int removerItemLista(No **inicio, const char *nome);
-void listarItensLista(const No *inicio);
+/* Prefixo/intervalo: O(log n + k) no vetor e na visão por nome da torre, O(n) na lista. */
+FaixaNomes faixaPrefixo(const char *prefixo);
+FaixaNomes faixaIntervalo(const char *de, const char *ate);
+int buscarFaixaVetor(const Item mochila[], int tamanho, FaixaNomes faixa, int *inicio, long *comparacoes);
+int buscarFaixaTorre(VetorComponentes *torre, FaixaNomes faixa, const int **indices, long *comparacoes);
+int buscarFaixaLista(const No *inicio, FaixaNomes faixa, const No *encontrados[], int maximo, long *comparacoes);
+int lerFaixaNomes(char de[], char ate[], FaixaNomes *faixa);
+void definirManterOrdenado(VetorItens *mochila, int ativo, int *ordenado);
+int buscarHashVetor(const VetorItens *mochila, const char *nome, long *sondagens);
+
+int inserirItemLista(ListaItens *lista, const char *nome, const char *tipo, int quantidade);
+int removerItemLista(ListaItens *lista, const char *nome);
+void listarItensLista(const ListaItens *lista);
 No *buscarSequencialLista(const No *inicio, const char *nome, long *comparacoes);
-void liberarLista(No **inicio);
+No *buscarHashLista(const ListaItens *lista, const char *nome, long *sondagens);
+void liberarLista(ListaItens *lista);
+
+No *alocarNo(PoolNos *pool);
+void devolverNo(PoolNos *pool, No *no);
+void liberarPool(PoolNos *pool);
+void mostrarEstatisticasPool(const PoolNos *pool);
+
+/* Índice hash: sondagens contadas para comparar com as buscas sequencial e binária. */
+const char *cortarNome(const char *nome, char chave[TAM_NOME]);
+unsigned int hashNome(const char *nome);
+EntradaHash *buscarHash(const IndiceHash *indice, const char *nome, long *sondagens);
+int inserirHash(IndiceHash *indice, const char *nome, int posicao, No *no);
+int removerHash(IndiceHash *indice, const char *nome);
+void deslocarPosicoesHash(IndiceHash *indice, int aPartirDe, int delta);
+void reconstruirHashVetor(VetorItens *mochila);
+void liberarHash(IndiceHash *indice);
+
+/* Árvore radix dos nomes: busca exata, autocompletar e top-k por peso em O(tamanho do nome + saída). */
+int inserirRadix(ArvoreRadix *arvore, const char *nome, int peso);
+int removerRadix(ArvoreRadix *arvore, const char *nome);
+int buscarRadix(const ArvoreRadix *arvore, const char *nome, int *peso, long *nosVisitados);
+int completarRadix(const ArvoreRadix *arvore, const char *prefixo, int porPeso, SugestaoRadix sugestoes[], int maximo, long *encontrados, long *nosVisitados);
+void mostrarMemoriaRadix(const ArvoreRadix *arvore, const IndiceHash *indice);
+void liberarRadix(ArvoreRadix *arvore);
+void menuRadix(const ArvoreRadix *arvore, const IndiceHash *indice, const char *rotuloPeso);
+
+int buscarTipo(const char *tipo);
+int internarTipo(const char *tipo);
+const char *nomeTipo(IdTipo id);
+int compararTipos(IdTipo a, IdTipo b);
+void mostrarMemoriaTipos(long registros);
+void liberarTabelaTipos(void);
+
+int inserirItemDesenrolada(ListaDesenrolada *lista, const char *nome, const char *tipo, int quantidade);
+int removerItemDesenrolada(ListaDesenrolada *lista, const char *nome);
+void listarItensDesenrolada(const ListaDesenrolada *lista);
+Item *buscarSequencialDesenrolada(const ListaDesenrolada *lista, const char *nome, long *comparacoes, long *nosVisitados);
+void liberarListaDesenrolada(ListaDesenrolada *lista);
+
+int sincronizarSoA(MochilaSoA *soa, const VetorItens *mochila);
+int buscarAssinaturaSoA(const MochilaSoA *soa, const char *nome, long *comparacoes);
+const char *caminhoSimdSoA(void);
+void compararBuscaSoA(MochilaSoA *soa, const VetorItens *mochila, const char *nome);
+void liberarSoA(MochilaSoA *soa);
 
 /* Funções do módulo Torre de Fuga */
-void cadastrarComponentes(Componente componentes[], int *total);
+void cadastrarComponentes(VetorComponentes *torre);
+void esvaziarTorre(VetorComponentes *torre);
+int adicionarComponente(VetorComponentes *torre, const char *nome, const char *tipo, int prioridade);
 void bubbleSortNome(Componente componentes[], int total, long *comparacoes);
 void insertionSortTipo(Componente componentes[], int total, long *comparacoes);
 void selectionSortPrioridade(Componente componentes[], int total, long *comparacoes);
+/* Counting sort estável O(n + k) para chaves de domínio pequeno (sem comparar elementos). */
+void countingSortPrioridade(Componente componentes[], int total, long *comparacoes);
+void countingSortTipo(Componente componentes[], int total, long *comparacoes);
 int buscaBinariaPorNome(Componente componentes[], int total, const char *nomeBuscado, long *comparacoes);
+
+/* Merge Sort estável O(n log n) com critério plugável (preserva a ordem entre empates). */
+typedef int (*ComparadorComponente)(const Componente *a, const Componente *b);
+int compararPorNome(const Componente *a, const Componente *b);
+int compararPorTipo(const Componente *a, const Componente *b);
+int compararPorPrioridade(const Componente *a, const Componente *b);
+int compararPorPrioridadeDescNome(const Componente *a, const Componente *b);
+int compararPorTipoPrioridadeDesc(const Componente *a, const Componente *b);
+void mergeSortComponentes(Componente componentes[], int total, ComparadorComponente comparar, long *comparacoes);
+void mergeSortNome(Componente componentes[], int total, long *comparacoes);
+void mergeSortTipo(Componente componentes[], int total, long *comparacoes);
+void mergeSortPrioridade(Componente componentes[], int total, long *comparacoes);
+
+/* Merge sort paralelo (pthreads): mesmas intercalações da versão sequencial repartidas entre threads. */
+int threadsDisponiveis(void);
+void mergeSortParalelo(Componente componentes[], int total, ComparadorComponente comparar, int threads, EstatisticasParalelo *estatisticas, long *comparacoes);
+void mergeSortItensParalelo(Item itens[], int total, int threads, EstatisticasParalelo *estatisticas, long *comparacoes);
+void mergeSortParaleloNome(Componente componentes[], int total, long *comparacoes);
+void mergeSortParaleloTipo(Componente componentes[], int total, long *comparacoes);
+void mergeSortParaleloPrioridade(Componente componentes[], int total, long *comparacoes);
+void mostrarEstatisticasParalelo(const EstatisticasParalelo *estatisticas);
+void curvaSpeedup(const Componente componentes[], int total, ComparadorComponente comparar, int maximo);
+
+/* Ordenação indireta: ordena permutações de índices e só reordena fisicamente sob demanda. */
+int ordenarVisao(VetorComponentes *torre, Criterio criterio, long *comparacoes);
+int garantirVisao(VetorComponentes *torre, Criterio criterio, long *comparacoes);
+void inserirNasVisoes(VetorComponentes *torre, int novo);
+int consultarTipoPrioridade(VetorComponentes *torre, const char *tipo, int prioridadeMinima, const int **resultado, long *comparacoes);
+int aplicarVisao(VetorComponentes *torre, Criterio criterio);
+void invalidarVisoes(VetorComponentes *torre);
+int buscaBinariaVisaoNome(const VetorComponentes *torre, const char *nomeBuscado, long *comparacoes);
+void mostrarVisao(const VetorComponentes *torre, Criterio criterio);
+
+/* Índice de Eytzinger: descida sem desvios com prefetch, alternativa à busca binária. */
+int construirEytzinger(IndiceEytzinger *indice, const char *primeiroNome, size_t passo, const int *ordem, int total);
+int buscarEytzinger(const IndiceEytzinger *indice, const char *nome, long *comparacoes);
+int sincronizarEytzingerVetor(VetorItens *mochila);
+int sincronizarEytzingerTorre(VetorComponentes *torre, int ordenadoPorNome, long *comparacoes);
+void liberarEytzinger(IndiceEytzinger *indice);
 void mostrarComponentes(const Componente componentes[], int total);
-double medirTempoOrdenacao(void (*algoritmo)(Componente[], int, long*), Componente componentes[], int total, long *comparacoes);
+EstatisticasTempo medirTempoOrdenacao(void (*algoritmo)(Componente[], int, long*), Componente componentes[], int total, long *comparacoes);
+
+/* Silencia avisar() enquanto um script é executado. */
+static int modoSilencioso = 0;
+
+/* Tabela única de tipos, compartilhada por vetor, listas e torre. */
+static TabelaTipos tabelaTipos;
+
+/* Quantas vezes buscas e ordenações são repetidas ao medir (opção 5 do menu principal). */
+static int repeticoesMedicao = 1;
+
+/* Trocas (bubble/selection) ou movimentos de elementos (insertion/merge) da
+ * última ordenação; zerado por quem mede, lido pelo benchmark. Uma cópia por
+ * thread: o merge sort paralelo soma as dos trabalhadores na da chamadora. */
+static __thread long trocasOrdenacao = 0;
+
+/* Threads do merge sort paralelo (0 = todas as CPUs) e contadores da última execução. */
+static int threadsOrdenacao = 0;
+static EstatisticasParalelo ultimaOrdenacaoParalela;
 
 /* Loop principal: permite escolher vetor ou lista e testar as operações em cada uma. */
-int main(void) {
-	Item mochilaVetor[CAPACIDADE_MAXIMA];
-	int tamanhoVetor = 0;
+int main(int argc, char *argv[]) {
+	const char *programa = argv[0];
+	const char *caminhoDiario = NULL;
+	if (argc >= 3 && strcmp(argv[1], "--journal") == 0) {
+		caminhoDiario = argv[2];
+		argc -= 2;
+		argv += 2;
+	}
+	if (argc == 3 && strcmp(argv[1], "--script") == 0) {
+		return executarScript(argv[2], caminhoDiario);
+	}
+	if (!caminhoDiario && argc >= 2 && argc <= 5 && strcmp(argv[1], "--bench") == 0) {
+		int tamanhoMaximo = 1000000;
+		int limiteQuadratico = 10000;
+		if ((argc > 3 && (!lerInteiroCampo(argv[3], &tamanhoMaximo) || tamanhoMaximo < 100))
+			|| (argc > 4 && (!lerInteiroCampo(argv[4], &limiteQuadratico) || limiteQuadratico < 0))) {
+			fprintf(stderr, "--bench: n maximo deve ser inteiro >= 100 e limite quadratico inteiro >= 0\n");
+			return 1;
+		}
+		return executarBenchmark(argc > 2 ? argv[2] : NULL, tamanhoMaximo, limiteQuadratico);
+	}
+	if (!caminhoDiario && argc >= 2 && argc <= 5 && strcmp(argv[1], "--stress") == 0) {
+		int leitores = threadsDisponiveis();
+		double segundos = 2.0;
+		int itens = 100000;
+		char *fimNumero = NULL;
+		if (argc > 3) {
+			segundos = strtod(argv[3], &fimNumero);
+		}
+		if ((argc > 2 && (!lerInteiroCampo(argv[2], &leitores) || leitores < 1 || leitores > MAX_THREADS_ORDENACAO))
+			|| (argc > 3 && (fimNumero == argv[3] || *fimNumero != '\0' || !(segundos > 0)))
+			|| (argc > 4 && (!lerInteiroCampo(argv[4], &itens) || itens < 1))) {
+			fprintf(stderr, "--stress: leitores inteiro de 1 a %d, segundos > 0 e itens inteiro >= 1\n", MAX_THREADS_ORDENACAO);
+			return 1;
+		}
+		int resultado = executarEstresse(leitores, segundos, itens);
+		liberarTabelaTipos();
+		return resultado;
+	}
+	if (argc > 1) {
+		fprintf(stderr, "Uso: %s [--journal arquivo] [--script arquivo] | --bench [saida.csv|saida.json|-] [n maximo] [limite quadratico]"
+			" | --stress [leitores] [segundos] [itens]\n", programa);
+		return 1;
+	}
+
+	VetorItens mochilaVetor = {0};
+	MochilaSoA mochilaSoA = {0};
 	int vetorOrdenado = 0;
-	No *inicioLista = NULL;
-	Componente componentesTorre[MAX_COMPONENTES];
-	int totalComponentes = 0;
+	ListaItens lista = {0};
+	ListaDesenrolada desenrolada = {0};
+	VetorComponentes torre = {0};
 	int ordenadoPorNome = 0;
+	Diario diario;
 
 	printf("Comparador de mochila: vetor x lista encadeada\n");
 	printf("+ MODULO TORRE DE FUGA\n\n");
+	if (caminhoDiario) {
+		ResultadoDiario recuperado;
+		if (!abrirDiario(&diario, caminhoDiario, &mochilaVetor, &vetorOrdenado, &lista, &torre, &ordenadoPorNome, &recuperado)) {
+			liberarVetor(&mochilaVetor);
+			liberarLista(&lista);
+			liberarComponentes(&torre);
+			liberarTabelaTipos();
+			return 1;
+		}
+		mostrarResultadoDiario(caminhoDiario, &recuperado);
+	}
 
 	for (;;) {
+		manterDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
 		int escolha = menuEstrutura();
 		if (escolha == 0) {
 			printf("Saindo... Bons saques!\n");
 			break;
 		}
+		if (escolha == 5) {
+			configurarRepeticoes();
+			continue;
+		}
+		if (escolha == 6 || escolha == 7) {
+			menuSnapshot(escolha == 7, &mochilaVetor, &vetorOrdenado, &lista, &torre, &ordenadoPorNome);
+			continue;
+		}
+		if (escolha == 8 || escolha == 9) {
+			menuCsv(escolha == 9, &mochilaVetor, &vetorOrdenado, &lista, &torre, &ordenadoPorNome);
+			continue;
+		}
+		if (escolha == 10) {
+			mostrarMemoriaTipos((long)mochilaVetor.tamanho + lista.tamanho + desenrolada.tamanho + torre.total);
+			continue;
+		}
+		if (escolha == 11) {
+			menuEstresse();
+			continue;
+		}
+		if (escolha == 12) {
+			if (!mochilaVetor.diario) {
+				printf("Diario desligado: inicie com --journal <arquivo>.\n");
+				continue;
+			}
+			mostrarEstatisticasDiario(&diario);
+			int ok = 0;
+			EstatisticasTempo tempo;
+			long long inicioNs = agoraNs();
+			ok = compactarDiario(&diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+			resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+			if (ok) {
+				printf("Diario compactado em snapshot. ");
+				imprimirTempo(&tempo);
+			}
+			continue;
+		}
 
 		if (escolha == 1) {
 			for (;;) {
+				descarregarDiario(mochilaVetor.diario);
 				int opcao = menuVetor();
 				if (opcao == 0) {
 					break;
@@ -108,40 +772,67 @@ int main(void) {
 							break;
 						}
 						limparBufferEntrada();
-						inserirItemVetor(mochilaVetor, &tamanhoVetor, nome, tipo, quantidade, &vetorOrdenado);
-						listarItensVetor(mochilaVetor, tamanhoVetor);
+						EstatisticasTempo tempo;
+						long long inicioNs = agoraNs();
+						inserirItemVetor(&mochilaVetor, nome, tipo, quantidade, &vetorOrdenado);
+						resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+						imprimirTempo(&tempo);
+						listarItensVetor(&mochilaVetor);
 						break;
 					}
 					case 2: {
 						char nome[TAM_NOME];
 						printf("Nome do item a remover: ");
 						lerLinha(nome, sizeof(nome));
-						removerItemVetor(mochilaVetor, &tamanhoVetor, nome, &vetorOrdenado);
-						listarItensVetor(mochilaVetor, tamanhoVetor);
+						EstatisticasTempo tempo;
+						long long inicioNs = agoraNs();
+						removerItemVetor(&mochilaVetor, nome, &vetorOrdenado);
+						resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+						imprimirTempo(&tempo);
+						listarItensVetor(&mochilaVetor);
 						break;
 					}
 					case 3:
-						listarItensVetor(mochilaVetor, tamanhoVetor);
+						listarItensVetor(&mochilaVetor);
 						break;
 					case 4:
-						if (ordenarVetor(mochilaVetor, tamanhoVetor)) {
+					case 16: {
+						long comparacoes = 0;
+						int ordenou = 0;
+						EstatisticasTempo tempo = medirOrdenacaoVetor(opcao == 4 ? ordenarVetor : ordenarVetorParaleloPadrao,
+							&mochilaVetor, &comparacoes, &ordenou);
+						if (ordenou) {
 							vetorOrdenado = 1;
-							printf("Vetor ordenado por nome (bubble sort).\n");
+							fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+							if (opcao == 4) {
+								printf("Vetor ordenado por nome (bubble sort). Comparacoes: %ld | ", comparacoes);
+							} else {
+								printf("Vetor ordenado por nome (merge sort paralelo, %d thread(s)). Comparacoes: %ld | ",
+									ultimaOrdenacaoParalela.threads, comparacoes);
+							}
+							imprimirTempo(&tempo);
 						} else {
 							printf("Nada para ordenar.\n");
 						}
 						break;
+					}
 					case 5: {
 						char nome[TAM_NOME];
 						long comparacoes = 0;
 						printf("Nome a buscar (sequencial): ");
 						lerLinha(nome, sizeof(nome));
-						int pos = buscarSequencialVetor(mochilaVetor, tamanhoVetor, nome, &comparacoes);
+						int pos = -1;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaSequencialVetor, &mochilaVetor, nome, 0);
+						tempo = medirConsulta(&consulta);
+						pos = consulta.resultado;
+						comparacoes = consulta.contador;
 						if (pos >= 0) {
-							printf("Encontrado na posicao %d. Comparacoes: %ld\n", pos + 1, comparacoes);
+							printf("Encontrado na posicao %d. Comparacoes: %ld | ", pos + 1, comparacoes);
 						} else {
-							printf("Nao encontrado. Comparacoes: %ld\n", comparacoes);
+							printf("Nao encontrado. Comparacoes: %ld | ", comparacoes);
 						}
+						imprimirTempo(&tempo);
 						break;
 					}
 					case 6: {
@@ -153,12 +844,147 @@ int main(void) {
 						}
 						printf("Nome a buscar (binaria): ");
 						lerLinha(nome, sizeof(nome));
-						int pos = buscarBinariaVetor(mochilaVetor, tamanhoVetor, nome, &comparacoes);
+						int pos = -1;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaBinariaVetor, &mochilaVetor, nome, 0);
+						tempo = medirConsulta(&consulta);
+						pos = consulta.resultado;
+						comparacoes = consulta.contador;
+						if (pos >= 0) {
+							printf("Encontrado na posicao %d. Comparacoes: %ld | ", pos + 1, comparacoes);
+						} else {
+							printf("Nao encontrado. Comparacoes: %ld | ", comparacoes);
+						}
+						imprimirTempo(&tempo);
+						break;
+					}
+					case 7: {
+						int capacidade;
+						printf("Capacidade desejada: ");
+						if (scanf("%d", &capacidade) != 1 || capacidade <= 0) {
+							printf("Capacidade invalida.\n");
+							limparBufferEntrada();
+							break;
+						}
+						limparBufferEntrada();
+						if (reservarVetor(&mochilaVetor, capacidade)) {
+							printf("Capacidade atual: %d itens.\n", mochilaVetor.capacidade);
+						}
+						break;
+					}
+					case 8:
+						compactarVetor(&mochilaVetor);
+						printf("Capacidade ajustada para %d itens.\n", mochilaVetor.capacidade);
+						break;
+					case 9: {
+						char nome[TAM_NOME];
+						long sondagens = 0;
+						printf("Nome a buscar (hash): ");
+						lerLinha(nome, sizeof(nome));
+						int pos = -1;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaHashVetor, &mochilaVetor, nome, 0);
+						tempo = medirConsulta(&consulta);
+						pos = consulta.resultado;
+						sondagens = consulta.contador;
+						if (pos >= 0) {
+							printf("Encontrado na posicao %d. Sondagens: %ld | ", pos + 1, sondagens);
+						} else {
+							printf("Nao encontrado. Sondagens: %ld | ", sondagens);
+						}
+						imprimirTempo(&tempo);
+						break;
+					}
+					case 10: {
+						char nome[TAM_NOME];
+						printf("Nome a buscar (SoA x AoS): ");
+						lerLinha(nome, sizeof(nome));
+						compararBuscaSoA(&mochilaSoA, &mochilaVetor, nome);
+						break;
+					}
+					case 11:
+						definirManterOrdenado(&mochilaVetor, !mochilaVetor.manterOrdenado, &vetorOrdenado);
+						fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+						printf("Manter ordenado: %s | Reordenacoes evitadas: %ld\n",
+							mochilaVetor.manterOrdenado ? "LIGADO (binaria sempre disponivel)" : "desligado",
+							mochilaVetor.reordenacoesEvitadas);
+						break;
+					case 12: {
+						if (!vetorOrdenado) {
+							printf("Ordene o vetor antes de usar busca binaria.\n");
+							break;
+						}
+						char de[TAM_NOME];
+						char ate[TAM_NOME];
+						FaixaNomes faixa;
+						if (!lerFaixaNomes(de, ate, &faixa)) {
+							break;
+						}
+						long comparacoes = 0;
+						int inicio = 0;
+						int encontrados = 0;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarFaixaVetor, &mochilaVetor, &faixa, 0);
+						tempo = medirConsulta(&consulta);
+						encontrados = consulta.resultado;
+						inicio = consulta.inicio;
+						comparacoes = consulta.contador;
+						printf("%d item(ns) nas posicoes %d-%d:\n", encontrados, inicio + 1, inicio + encontrados);
+						for (int i = 0; i < encontrados && i < MAX_FAIXA_EXIBIDA; i++) {
+							const Item *item = &mochilaVetor.itens[inicio + i];
+							printf("  %s | %s | qtd %d\n", item->nome, nomeTipo(item->tipo), item->quantidade);
+						}
+						if (encontrados > MAX_FAIXA_EXIBIDA) {
+							printf("  ... e mais %d\n", encontrados - MAX_FAIXA_EXIBIDA);
+						}
+						printf("Comparacoes: %ld | ", comparacoes);
+						imprimirTempo(&tempo);
+						break;
+					}
+					case 13:
+						menuRadix(&mochilaVetor.radix, &mochilaVetor.indice, "qtd");
+						break;
+					case 14:
+						menuLote(CSV_VETOR, &mochilaVetor, vetorOrdenado, &lista, &torre);
+						break;
+					case 15: {
+						char nome[TAM_NOME];
+						if (!vetorOrdenado) {
+							printf("Ordene o vetor antes de montar o indice Eytzinger.\n");
+							break;
+						}
+						printf("Nome a buscar (Eytzinger): ");
+						lerLinha(nome, sizeof(nome));
+						EstatisticasTempo tempoIndice;
+						int ok = 0;
+						long long inicioIndice = agoraNs();
+						ok = sincronizarEytzingerVetor(&mochilaVetor);
+						resumirAmostraUnica(&tempoIndice, agoraNs() - inicioIndice);
+						if (!ok) {
+							break;
+						}
+						printf("Indice pronto (%d nos, %zu bytes de nomes) | ", mochilaVetor.eytzinger.total,
+							(size_t)(mochilaVetor.eytzinger.total + 1) * TAM_NO_EYTZINGER);
+						imprimirTempo(&tempoIndice);
+						long comparacoes = 0;
+						int pos = -1;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaEytzinger, &mochilaVetor.eytzinger, nome, 0);
+						tempo = medirConsulta(&consulta);
+						pos = consulta.resultado;
+						comparacoes = consulta.contador;
 						if (pos >= 0) {
-							printf("Encontrado na posicao %d. Comparacoes: %ld\n", pos + 1, comparacoes);
+							printf("Encontrado na posicao %d. Comparacoes: %ld | ", pos + 1, comparacoes);
 						} else {
-							printf("Nao encontrado. Comparacoes: %ld\n", comparacoes);
+							printf("Nao encontrado. Comparacoes: %ld | ", comparacoes);
 						}
+						imprimirTempo(&tempo);
+						ConsultaMedida binaria = novaConsulta(executarBuscaBinariaVetor, &mochilaVetor, nome, 0);
+						tempo = medirConsulta(&binaria);
+						pos = binaria.resultado;
+						comparacoes = binaria.contador;
+						printf("Binaria para comparar. Comparacoes: %ld | ", comparacoes);
+						imprimirTempo(&tempo);
 						break;
 					}
 					default:
@@ -168,6 +994,7 @@ int main(void) {
 			}
 		} else if (escolha == 2) {
 			for (;;) {
+				descarregarDiario(mochilaVetor.diario);
 				int opcao = menuLista();
 				if (opcao == 0) {
 					break;
@@ -190,34 +1017,103 @@ int main(void) {
 							break;
 						}
 						limparBufferEntrada();
-						inserirItemLista(&inicioLista, nome, tipo, quantidade);
-						listarItensLista(inicioLista);
+						EstatisticasTempo tempo;
+						long long inicioNs = agoraNs();
+						inserirItemLista(&lista, nome, tipo, quantidade);
+						resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+						imprimirTempo(&tempo);
+						listarItensLista(&lista);
 						break;
 					}
 					case 2: {
 						char nome[TAM_NOME];
 						printf("Nome do item a remover: ");
 						lerLinha(nome, sizeof(nome));
-						removerItemLista(&inicioLista, nome);
-						listarItensLista(inicioLista);
+						EstatisticasTempo tempo;
+						long long inicioNs = agoraNs();
+						removerItemLista(&lista, nome);
+						resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+						imprimirTempo(&tempo);
+						listarItensLista(&lista);
 						break;
 					}
 					case 3:
-						listarItensLista(inicioLista);
+						listarItensLista(&lista);
 						break;
 					case 4: {
 						char nome[TAM_NOME];
 						long comparacoes = 0;
 						printf("Nome a buscar (sequencial lista): ");
 						lerLinha(nome, sizeof(nome));
-						No *encontrado = buscarSequencialLista(inicioLista, nome, &comparacoes);
+						const No *encontrado = NULL;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaSequencialLista, &lista, nome, 0);
+						tempo = medirConsulta(&consulta);
+						encontrado = (const No *)consulta.achado;
+						comparacoes = consulta.contador;
+						if (encontrado) {
+							printf("Encontrado: %s | %s | qtd %d. Comparacoes: %ld | ", encontrado->dados.nome, nomeTipo(encontrado->dados.tipo), encontrado->dados.quantidade, comparacoes);
+						} else {
+							printf("Nao encontrado. Comparacoes: %ld | ", comparacoes);
+						}
+						imprimirTempo(&tempo);
+						break;
+					}
+					case 5: {
+						char nome[TAM_NOME];
+						long sondagens = 0;
+						printf("Nome a buscar (hash lista): ");
+						lerLinha(nome, sizeof(nome));
+						const No *encontrado = NULL;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaHashLista, &lista, nome, 0);
+						tempo = medirConsulta(&consulta);
+						encontrado = (const No *)consulta.achado;
+						sondagens = consulta.contador;
 						if (encontrado) {
-							printf("Encontrado: %s | %s | qtd %d. Comparacoes: %ld\n", encontrado->dados.nome, encontrado->dados.tipo, encontrado->dados.quantidade, comparacoes);
+							printf("Encontrado: %s | %s | qtd %d. Sondagens: %ld | ", encontrado->dados.nome, nomeTipo(encontrado->dados.tipo), encontrado->dados.quantidade, sondagens);
 						} else {
-							printf("Nao encontrado. Comparacoes: %ld\n", comparacoes);
+							printf("Nao encontrado. Sondagens: %ld | ", sondagens);
+						}
+						imprimirTempo(&tempo);
+						break;
+					}
+					case 6:
+						mostrarEstatisticasPool(&lista.pool);
+						break;
+					case 7: {
+						char de[TAM_NOME];
+						char ate[TAM_NOME];
+						FaixaNomes faixa;
+						if (!lerFaixaNomes(de, ate, &faixa)) {
+							break;
 						}
+						const No *encontrados[MAX_FAIXA_EXIBIDA];
+						long comparacoes = 0;
+						int total = 0;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarFaixaLista, &lista, &faixa, 0);
+						consulta.nos = encontrados;
+						tempo = medirConsulta(&consulta);
+						total = consulta.resultado;
+						comparacoes = consulta.contador;
+						printf("%d item(ns):\n", total);
+						for (int i = 0; i < total && i < MAX_FAIXA_EXIBIDA; i++) {
+							printf("  %s | %s | qtd %d\n", encontrados[i]->dados.nome, nomeTipo(encontrados[i]->dados.tipo), encontrados[i]->dados.quantidade);
+						}
+						if (total > MAX_FAIXA_EXIBIDA) {
+							printf("  ... e mais %d\n", total - MAX_FAIXA_EXIBIDA);
+						}
+						printf("Comparacoes: %ld | ", comparacoes);
+						imprimirTempo(&tempo);
 						break;
 					}
+					case 8:
+						menuRadix(&lista.radix, &lista.indice, "qtd");
+						break;
+					case 9:
+						menuLote(CSV_LISTA, &mochilaVetor, vetorOrdenado, &lista, &torre);
+						break;
 					default:
 						printf("Opcao invalida.\n");
 						break;
@@ -226,6 +1122,7 @@ int main(void) {
 		} else if (escolha == 3) {
 			/* Módulo Torre de Fuga */
 			for (;;) {
+				descarregarDiario(mochilaVetor.diario);
 				int opcao = menuTorreFuga();
 				if (opcao == 0) {
 					break;
@@ -233,161 +1130,561 @@ int main(void) {
 
 				switch (opcao) {
 					case 1: {
-						cadastrarComponentes(componentesTorre, &totalComponentes);
+						cadastrarComponentes(&torre);
 						ordenadoPorNome = 0;
 						break;
 					}
 					case 2: {
-						if (totalComponentes == 0) {
+						if (torre.total == 0) {
 							printf("Nenhum componente cadastrado.\n");
 							break;
 						}
 						{
 							long comparacoes = 0;
-							double tempo;
+							EstatisticasTempo tempo;
 							printf("\n>>> BUBBLE SORT por NOME...\n");
-							tempo = medirTempoOrdenacao(bubbleSortNome, componentesTorre, totalComponentes, &comparacoes);
+							tempo = medirTempoOrdenacao(bubbleSortNome, torre.itens, torre.total, &comparacoes);
 							printf("Ordenacao concluida!\n");
-							printf("Comparacoes: %ld | Tempo: %.6f s\n", comparacoes, tempo);
-							mostrarComponentes(componentesTorre, totalComponentes);
+							printf("Comparacoes: %ld | ", comparacoes);
+							imprimirTempo(&tempo);
+							mostrarComponentes(torre.itens, torre.total);
 							ordenadoPorNome = 1;
+							invalidarVisoes(&torre);
+							fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
 						}
 						break;
 					}
 					case 3: {
-						if (totalComponentes == 0) {
+						if (torre.total == 0) {
 							printf("Nenhum componente cadastrado.\n");
 							break;
 						}
 						{
 							long comparacoes = 0;
-							double tempo;
+							EstatisticasTempo tempo;
 							printf("\n>>> INSERTION SORT por TIPO...\n");
-							tempo = medirTempoOrdenacao(insertionSortTipo, componentesTorre, totalComponentes, &comparacoes);
+							tempo = medirTempoOrdenacao(insertionSortTipo, torre.itens, torre.total, &comparacoes);
 							printf("Ordenacao concluida!\n");
-							printf("Comparacoes: %ld | Tempo: %.6f s\n", comparacoes, tempo);
-							mostrarComponentes(componentesTorre, totalComponentes);
+							printf("Comparacoes: %ld | ", comparacoes);
+							imprimirTempo(&tempo);
+							mostrarComponentes(torre.itens, torre.total);
 							ordenadoPorNome = 0;
+							invalidarVisoes(&torre);
+							fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
 						}
 						break;
 					}
 					case 4: {
-						if (totalComponentes == 0) {
+						if (torre.total == 0) {
 							printf("Nenhum componente cadastrado.\n");
 							break;
 						}
 						{
 							long comparacoes = 0;
-							double tempo;
+							EstatisticasTempo tempo;
 							printf("\n>>> SELECTION SORT por PRIORIDADE...\n");
-							tempo = medirTempoOrdenacao(selectionSortPrioridade, componentesTorre, totalComponentes, &comparacoes);
+							tempo = medirTempoOrdenacao(selectionSortPrioridade, torre.itens, torre.total, &comparacoes);
 							printf("Ordenacao concluida!\n");
-							printf("Comparacoes: %ld | Tempo: %.6f s\n", comparacoes, tempo);
-							mostrarComponentes(componentesTorre, totalComponentes);
+							printf("Comparacoes: %ld | ", comparacoes);
+							imprimirTempo(&tempo);
+							mostrarComponentes(torre.itens, torre.total);
 							ordenadoPorNome = 0;
+							invalidarVisoes(&torre);
+							fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
 						}
 						break;
 					}
 					case 5: {
-						if (totalComponentes == 0) {
+						if (torre.total == 0) {
 							printf("Nenhum componente cadastrado.\n");
 							break;
 						}
 						if (!ordenadoPorNome) {
-							printf("\n[ATENCAO] Ordene por NOME antes (opcao 2)!\n");
-							break;
+							long comparacoesVisao = 0;
+							if (!garantirVisao(&torre, CRITERIO_NOME, &comparacoesVisao)) {
+								break;
+							}
 						}
 						{
 							char nomeBuscado[TAM_NOME];
 							long comparacoes = 0;
-							int pos;
+							int pos = -1;
 							printf("\n>>> BUSCA BINARIA <<<\n");
 							printf("Nome do componente-chave: ");
 							lerLinha(nomeBuscado, sizeof(nomeBuscado));
-							pos = buscaBinariaPorNome(componentesTorre, totalComponentes, nomeBuscado, &comparacoes);
+							EstatisticasTempo tempo;
+							if (!ordenadoPorNome) {
+								printf("(usando a visao indireta por nome)\n");
+							}
+							ConsultaMedida consulta = novaConsulta(executarBuscaBinariaTorre, &torre, nomeBuscado, ordenadoPorNome);
+							tempo = medirConsulta(&consulta);
+							pos = consulta.resultado;
+							comparacoes = consulta.contador;
 							if (pos >= 0) {
 								printf("\n[COMPONENTE ENCONTRADO!]\n");
 								printf("Posicao: %d\n", pos + 1);
-								printf("%s | %s | prioridade %d\n", componentesTorre[pos].nome, componentesTorre[pos].tipo, componentesTorre[pos].prioridade);
-								printf("Comparacoes: %ld\n", comparacoes);
+								printf("%s | %s | prioridade %d\n", torre.itens[pos].nome, nomeTipo(torre.itens[pos].tipo), torre.itens[pos].prioridade);
+								printf("Comparacoes: %ld | ", comparacoes);
+								imprimirTempo(&tempo);
 								printf(">>> Torre destrancada! <<<\n");
 							} else {
-								printf("\nNao encontrado. Comparacoes: %ld\n", comparacoes);
+								printf("\nNao encontrado. Comparacoes: %ld | ", comparacoes);
+								imprimirTempo(&tempo);
 							}
 						}
 						break;
 					}
 					case 6: {
-						if (totalComponentes == 0) {
+						if (torre.total == 0) {
 							printf("Nenhum componente cadastrado.\n");
 						} else {
-							mostrarComponentes(componentesTorre, totalComponentes);
+							mostrarComponentes(torre.itens, torre.total);
 						}
 						break;
 					}
-					default:
-						printf("Opcao invalida.\n");
+					case 7: {
+						if (torre.total == 0) {
+							printf("Nenhum componente cadastrado.\n");
+							break;
+						}
+						{
+							int criterio;
+							long comparacoes = 0;
+							EstatisticasTempo tempo;
+							printf("Criterio (1-Nome, 2-Tipo, 3-Prioridade): ");
+							if (scanf("%d", &criterio) != 1 || criterio < 1 || criterio > 3) {
+								printf("Criterio invalido.\n");
+								limparBufferEntrada();
+								break;
+							}
+							limparBufferEntrada();
+							printf("\n>>> MERGE SORT por %s...\n", criterio == 1 ? "NOME" : criterio == 2 ? "TIPO" : "PRIORIDADE");
+							if (criterio == 1) {
+								tempo = medirTempoOrdenacao(mergeSortNome, torre.itens, torre.total, &comparacoes);
+							} else if (criterio == 2) {
+								tempo = medirTempoOrdenacao(mergeSortTipo, torre.itens, torre.total, &comparacoes);
+							} else {
+								tempo = medirTempoOrdenacao(mergeSortPrioridade, torre.itens, torre.total, &comparacoes);
+							}
+							printf("Ordenacao concluida!\n");
+							printf("Comparacoes: %ld | ", comparacoes);
+							imprimirTempo(&tempo);
+							mostrarComponentes(torre.itens, torre.total);
+							ordenadoPorNome = criterio == 1;
+							invalidarVisoes(&torre);
+							fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+						}
 						break;
-				}
-			}
-		}
-	}
-
-	liberarLista(&inicioLista);
-	return 0;
-}
-
-/* Descarta caracteres até o próximo \n para evitar lixo em leituras futuras. */
-void limparBufferEntrada(void) {
-	int c;
-	while ((c = getchar()) != '\n' && c != EOF) {
-	}
-}
-
-/* Lê linha segura e remove o \n final, se presente. */
-void lerLinha(char *destino, size_t tamanho) {
-	if (fgets(destino, (int)tamanho, stdin) == NULL) {
-		destino[0] = '\0';
-		return;
-	}
-	size_t len = strlen(destino);
-	if (len > 0 && destino[len - 1] == '\n') {
-		destino[len - 1] = '\0';
-	}
-}
-
-int menuEstrutura(void) {
-	int opcao;
-	printf("\n=== Selecione a estrutura ===\n");
-	printf("1) Vetor (lista sequencial)\n");
-	printf("2) Lista encadeada\n");
-	printf("3) Torre de Fuga (DESAFIO FINAL)\n");
-	printf("0) Sair\n");
-	printf("Escolha: ");
-	if (scanf("%d", &opcao) != 1) {
-		opcao = 0;
-	}
-	limparBufferEntrada();
-	return opcao;
-}
-
-/* Menu dedicado ao vetor para operar com inserção, remoção, ordenação e buscas. */
-int menuVetor(void) {
-	int opcao;
-	printf("\n--- Mochila (vetor) ---\n");
-	printf("1) Inserir item\n");
-	printf("2) Remover item\n");
-	printf("3) Listar itens\n");
-	printf("4) Ordenar por nome\n");
-	printf("5) Buscar sequencial\n");
-	printf("6) Buscar binaria\n");
-	printf("0) Voltar\n");
-	printf("Escolha: ");
-	if (scanf("%d", &opcao) != 1) {
-		opcao = 0;
-	}
-	limparBufferEntrada();
-	return opcao;
+					}
+					case 8:
+					case 9:
+					case 10: {
+						if (torre.total == 0) {
+							printf("Nenhum componente cadastrado.\n");
+							break;
+						}
+						int criterio;
+						printf("Criterio (1-Nome, 2-Tipo, 3-Prioridade, 4-Prioridade desc+Nome, 5-Tipo+Prioridade desc): ");
+						if (scanf("%d", &criterio) != 1 || criterio < 1 || criterio > TOTAL_CRITERIOS) {
+							printf("Criterio invalido.\n");
+							limparBufferEntrada();
+							break;
+						}
+						limparBufferEntrada();
+						Criterio escolhido = (Criterio)(criterio - 1);
+						long comparacoesVisao = 0;
+						if (opcao == 8) {
+							long comparacoes = 0;
+							int ok = 0;
+							EstatisticasTempo tempo;
+							ConsultaMedida consulta = novaConsulta(executarOrdenarVisao, &torre, NULL, (int)escolhido);
+							tempo = medirConsulta(&consulta);
+							ok = consulta.resultado;
+							comparacoes = consulta.contador;
+							if (ok) {
+								printf("Visao por indices pronta (componentes nao foram movidos).\n");
+								printf("Comparacoes: %ld | ", comparacoes);
+								imprimirTempo(&tempo);
+							}
+						} else if (!garantirVisao(&torre, escolhido, &comparacoesVisao)) {
+							break;
+						} else if (opcao == 9) {
+							mostrarVisao(&torre, escolhido);
+						} else if (aplicarVisao(&torre, escolhido)) {
+							ordenadoPorNome = escolhido == CRITERIO_NOME;
+							fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+							printf("Componentes reordenados fisicamente pela visao.\n");
+							mostrarComponentes(torre.itens, torre.total);
+						}
+						break;
+					}
+					case 11: {
+						char tipo[TAM_TIPO];
+						int prioridadeMinima;
+						printf("Tipo: ");
+						lerLinha(tipo, sizeof(tipo));
+						printf("Prioridade minima (1-10): ");
+						if (scanf("%d", &prioridadeMinima) != 1) {
+							printf("Prioridade invalida.\n");
+							limparBufferEntrada();
+							break;
+						}
+						limparBufferEntrada();
+						const int *faixa = NULL;
+						long comparacoes = 0;
+						int encontrados = 0;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarConsultaTipoPrioridade, &torre, tipo, prioridadeMinima);
+						tempo = medirConsulta(&consulta);
+						encontrados = consulta.resultado;
+						faixa = consulta.indices;
+						comparacoes = consulta.contador;
+						printf("\n%d componente(s) '%s' com prioridade >= %d:\n", encontrados, tipo, prioridadeMinima);
+						for (int i = 0; i < encontrados; i++) {
+							const Componente *c = &torre.itens[faixa[i]];
+							printf("  %s | %s | prioridade %d\n", c->nome, nomeTipo(c->tipo), c->prioridade);
+						}
+						printf("Comparacoes: %ld | ", comparacoes);
+						imprimirTempo(&tempo);
+						break;
+					}
+					case 12: {
+						if (torre.total == 0) {
+							printf("Nenhum componente cadastrado.\n");
+							break;
+						}
+						int chave;
+						printf("Chave (1-Prioridade, 2-Tipo): ");
+						if (scanf("%d", &chave) != 1 || chave < 1 || chave > 2) {
+							printf("Chave invalida.\n");
+							limparBufferEntrada();
+							break;
+						}
+						limparBufferEntrada();
+						long comparacoes = 0;
+						printf("\n>>> COUNTING SORT por %s...\n", chave == 1 ? "PRIORIDADE" : "TIPO");
+						EstatisticasTempo tempo = medirTempoOrdenacao(chave == 1 ? countingSortPrioridade : countingSortTipo,
+							torre.itens, torre.total, &comparacoes);
+						printf("Ordenacao concluida!\n");
+						printf("Movimentos: %ld | Comparacoes: %ld | ", trocasOrdenacao, comparacoes);
+						imprimirTempo(&tempo);
+						mostrarComponentes(torre.itens, torre.total);
+						ordenadoPorNome = 0;
+						invalidarVisoes(&torre);
+						fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+						break;
+					}
+					case 13: {
+						char de[TAM_NOME];
+						char ate[TAM_NOME];
+						FaixaNomes faixa;
+						if (!lerFaixaNomes(de, ate, &faixa)) {
+							break;
+						}
+						const int *indices = NULL;
+						long comparacoes = 0;
+						int encontrados = 0;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarFaixaTorre, &torre, &faixa, 0);
+						tempo = medirConsulta(&consulta);
+						encontrados = consulta.resultado;
+						indices = consulta.indices;
+						comparacoes = consulta.contador;
+						printf("%d componente(s):\n", encontrados);
+						for (int i = 0; i < encontrados && i < MAX_FAIXA_EXIBIDA; i++) {
+							const Componente *c = &torre.itens[indices[i]];
+							printf("  %s | %s | prioridade %d\n", c->nome, nomeTipo(c->tipo), c->prioridade);
+						}
+						if (encontrados > MAX_FAIXA_EXIBIDA) {
+							printf("  ... e mais %d\n", encontrados - MAX_FAIXA_EXIBIDA);
+						}
+						printf("Comparacoes: %ld | ", comparacoes);
+						imprimirTempo(&tempo);
+						break;
+					}
+					case 14:
+						menuRadix(&torre.radix, NULL, "prioridade");
+						break;
+					case 15:
+					case 16: {
+						if (torre.total == 0) {
+							printf("Nenhum componente cadastrado.\n");
+							break;
+						}
+						int criterio;
+						int threads;
+						printf("Criterio (1-Nome, 2-Tipo, 3-Prioridade): ");
+						if (scanf("%d", &criterio) != 1 || criterio < 1 || criterio > 3) {
+							printf("Criterio invalido.\n");
+							limparBufferEntrada();
+							break;
+						}
+						printf(opcao == 15 ? "Threads (1-%d, 0 = todas as %d CPUs): " : "Maximo de threads (1-%d, 0 = todas as %d CPUs): ",
+							MAX_THREADS_ORDENACAO, threadsDisponiveis());
+						if (scanf("%d", &threads) != 1 || threads < 0 || threads > MAX_THREADS_ORDENACAO) {
+							printf("Numero de threads invalido.\n");
+							limparBufferEntrada();
+							break;
+						}
+						limparBufferEntrada();
+						if (opcao == 16) {
+							ComparadorComponente comparar = criterio == 1 ? compararPorNome : criterio == 2 ? compararPorTipo : compararPorPrioridade;
+							curvaSpeedup(torre.itens, torre.total, comparar, threads > 0 ? threads : threadsDisponiveis());
+							break;
+						}
+						threadsOrdenacao = threads;
+						long comparacoes = 0;
+						printf("\n>>> MERGE SORT PARALELO por %s...\n", criterio == 1 ? "NOME" : criterio == 2 ? "TIPO" : "PRIORIDADE");
+						EstatisticasTempo tempo = medirTempoOrdenacao(criterio == 1 ? mergeSortParaleloNome
+							: criterio == 2 ? mergeSortParaleloTipo : mergeSortParaleloPrioridade, torre.itens, torre.total, &comparacoes);
+						printf("Ordenacao concluida com %d thread(s)!\n", ultimaOrdenacaoParalela.threads);
+						mostrarEstatisticasParalelo(&ultimaOrdenacaoParalela);
+						printf("Comparacoes: %ld | ", comparacoes);
+						imprimirTempo(&tempo);
+						mostrarComponentes(torre.itens, torre.total);
+						ordenadoPorNome = criterio == 1;
+						invalidarVisoes(&torre);
+						fixarOrdemDiario(mochilaVetor.diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+						break;
+					}
+					case 17:
+						menuLote(CSV_TORRE, &mochilaVetor, vetorOrdenado, &lista, &torre);
+						break;
+					case 18: {
+						if (torre.total == 0) {
+							printf("Nenhum componente cadastrado.\n");
+							break;
+						}
+						char nomeBuscado[TAM_NOME];
+						long comparacoesIndice = 0;
+						printf("Nome do componente-chave (Eytzinger): ");
+						lerLinha(nomeBuscado, sizeof(nomeBuscado));
+						EstatisticasTempo tempoIndice;
+						int ok = 0;
+						long long inicioIndice = agoraNs();
+						ok = sincronizarEytzingerTorre(&torre, ordenadoPorNome, &comparacoesIndice);
+						resumirAmostraUnica(&tempoIndice, agoraNs() - inicioIndice);
+						if (!ok) {
+							break;
+						}
+						printf("Indice pronto (%d nos%s) | ", torre.eytzinger.total, ordenadoPorNome ? "" : ", lido pela visao por nome");
+						imprimirTempo(&tempoIndice);
+						long comparacoes = 0;
+						int pos = -1;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaEytzinger, &torre.eytzinger, nomeBuscado, 0);
+						tempo = medirConsulta(&consulta);
+						pos = consulta.resultado;
+						comparacoes = consulta.contador;
+						if (pos >= 0) {
+							printf("%s | %s | prioridade %d (posicao %d)\n", torre.itens[pos].nome, nomeTipo(torre.itens[pos].tipo),
+								torre.itens[pos].prioridade, pos + 1);
+							printf("Comparacoes: %ld | ", comparacoes);
+						} else {
+							printf("Nao encontrado. Comparacoes: %ld | ", comparacoes);
+						}
+						imprimirTempo(&tempo);
+						ConsultaMedida binaria = novaConsulta(executarBuscaBinariaTorre, &torre, nomeBuscado, ordenadoPorNome);
+						tempo = medirConsulta(&binaria);
+						pos = binaria.resultado;
+						comparacoes = binaria.contador;
+						printf("Binaria para comparar. Comparacoes: %ld | ", comparacoes);
+						imprimirTempo(&tempo);
+						break;
+					}
+					default:
+						printf("Opcao invalida.\n");
+						break;
+				}
+			}
+		} else if (escolha == 4) {
+			for (;;) {
+				int opcao = menuListaDesenrolada();
+				if (opcao == 0) {
+					break;
+				}
+
+				switch (opcao) {
+					case 1: {
+						char nome[TAM_NOME];
+						char tipo[TAM_TIPO];
+						int quantidade;
+
+						printf("Nome do item: ");
+						lerLinha(nome, sizeof(nome));
+						printf("Tipo do item: ");
+						lerLinha(tipo, sizeof(tipo));
+						printf("Quantidade: ");
+						if (scanf("%d", &quantidade) != 1) {
+							printf("Quantidade invalida.\n");
+							limparBufferEntrada();
+							break;
+						}
+						limparBufferEntrada();
+						EstatisticasTempo tempo;
+						long long inicioNs = agoraNs();
+						inserirItemDesenrolada(&desenrolada, nome, tipo, quantidade);
+						resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+						imprimirTempo(&tempo);
+						listarItensDesenrolada(&desenrolada);
+						break;
+					}
+					case 2: {
+						char nome[TAM_NOME];
+						printf("Nome do item a remover: ");
+						lerLinha(nome, sizeof(nome));
+						EstatisticasTempo tempo;
+						long long inicioNs = agoraNs();
+						removerItemDesenrolada(&desenrolada, nome);
+						resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+						imprimirTempo(&tempo);
+						listarItensDesenrolada(&desenrolada);
+						break;
+					}
+					case 3:
+						listarItensDesenrolada(&desenrolada);
+						break;
+					case 4: {
+						char nome[TAM_NOME];
+						long comparacoes = 0;
+						long nosVisitados = 0;
+						printf("Nome a buscar (sequencial lista desenrolada): ");
+						lerLinha(nome, sizeof(nome));
+						const Item *encontrado = NULL;
+						EstatisticasTempo tempo;
+						ConsultaMedida consulta = novaConsulta(executarBuscaDesenrolada, &desenrolada, nome, 0);
+						tempo = medirConsulta(&consulta);
+						encontrado = (const Item *)consulta.achado;
+						comparacoes = consulta.contador;
+						nosVisitados = consulta.nosVisitados;
+						if (encontrado) {
+							printf("Encontrado: %s | %s | qtd %d. Comparacoes: %ld | Nos visitados: %ld | ", encontrado->nome, nomeTipo(encontrado->tipo), encontrado->quantidade, comparacoes, nosVisitados);
+						} else {
+							printf("Nao encontrado. Comparacoes: %ld | Nos visitados: %ld | ", comparacoes, nosVisitados);
+						}
+						imprimirTempo(&tempo);
+						break;
+					}
+					default:
+						printf("Opcao invalida.\n");
+						break;
+				}
+			}
+		}
+	}
+
+	if (mochilaVetor.diario) {
+		fecharDiario(&diario);
+		mostrarEstatisticasDiario(&diario);
+	}
+	liberarVetor(&mochilaVetor);
+	liberarSoA(&mochilaSoA);
+	liberarLista(&lista);
+	liberarListaDesenrolada(&desenrolada);
+	liberarComponentes(&torre);
+	liberarTabelaTipos();
+	return 0;
+}
+
+/* Descarta caracteres até o próximo \n para evitar lixo em leituras futuras. */
+void limparBufferEntrada(void) {
+	int c;
+	while ((c = getchar()) != '\n' && c != EOF) {
+	}
+}
+
+/* printf condicionado ao modo silencioso usado pelo processamento em lote. */
+void avisar(const char *formato, ...) {
+	if (modoSilencioso) {
+		return;
+	}
+	va_list args;
+	va_start(args, formato);
+	vprintf(formato, args);
+	va_end(args);
+}
+
+/* Relógio monotônico em segundos, imune a ajustes de data do sistema. */
+double tempoMonotonico(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+/* Converte o campo inteiro; recusa vazio, lixo no fim ou estouro de int. */
+int lerInteiroCampo(const char *campo, int *valor) {
+	char *fimNumero;
+	long convertido = strtol(campo, &fimNumero, 10);
+	if (fimNumero == campo || *fimNumero != '\0' || convertido < -2147483647L || convertido > 2147483647L) {
+		return 0;
+	}
+	*valor = (int)convertido;
+	return 1;
+}
+
+/* Lê linha segura e remove o \n final, se presente. */
+void lerLinha(char *destino, size_t tamanho) {
+	if (fgets(destino, (int)tamanho, stdin) == NULL) {
+		destino[0] = '\0';
+		return;
+	}
+	size_t len = strlen(destino);
+	if (len > 0 && destino[len - 1] == '\n') {
+		destino[len - 1] = '\0';
+	}
+}
+
+int menuEstrutura(void) {
+	int opcao;
+	printf("\n=== Selecione a estrutura ===\n");
+	printf("1) Vetor (lista sequencial)\n");
+	printf("2) Lista encadeada\n");
+	printf("3) Torre de Fuga (DESAFIO FINAL)\n");
+	printf("4) Lista desenrolada (%d itens por no)\n", ITENS_POR_BLOCO);
+	printf("5) Configurar repeticoes de medicao (atual: %d)\n", repeticoesMedicao);
+	printf("6) Salvar snapshot (vetor, lista e torre)\n");
+	printf("7) Carregar snapshot\n");
+	printf("8) Importar CSV\n");
+	printf("9) Exportar CSV\n");
+	printf("10) Tabela de tipos e memoria economizada\n");
+	printf("11) Teste de estresse concorrente (leitores x escritor)\n");
+	printf("12) Diario de operacoes: estatisticas e compactar agora\n");
+	printf("0) Sair\n");
+	printf("Escolha: ");
+	if (scanf("%d", &opcao) != 1) {
+		opcao = 0;
+	}
+	limparBufferEntrada();
+	return opcao;
+}
+
+/* Menu dedicado ao vetor para operar com inserção, remoção, ordenação e buscas. */
+int menuVetor(void) {
+	int opcao;
+	printf("\n--- Mochila (vetor) ---\n");
+	printf("1) Inserir item\n");
+	printf("2) Remover item\n");
+	printf("3) Listar itens\n");
+	printf("4) Ordenar por nome\n");
+	printf("5) Buscar sequencial\n");
+	printf("6) Buscar binaria\n");
+	printf("7) Reservar capacidade\n");
+	printf("8) Compactar memoria (shrink-to-fit)\n");
+	printf("9) Busca por hash\n");
+	printf("10) Busca SoA com filtro SIMD (ns/busca vs vetor)\n");
+	printf("11) Manter sempre ordenado (liga/desliga)\n");
+	printf("12) Buscar por prefixo ou intervalo de nomes (binaria)\n");
+	printf("13) Autocompletar nomes (arvore radix)\n");
+	printf("14) Buscar lote de nomes de um arquivo\n");
+	printf("15) Busca Eytzinger (layout BFS, sem desvios, prefetch) x binaria\n");
+	printf("16) Ordenar por nome (merge sort paralelo)\n");
+	printf("0) Voltar\n");
+	printf("Escolha: ");
+	if (scanf("%d", &opcao) != 1) {
+		opcao = 0;
+	}
+	limparBufferEntrada();
+	return opcao;
 }
 
 /* Menu dedicado à lista encadeada para inserir, remover, listar e buscar. */
@@ -398,6 +1695,11 @@ int menuLista(void) {
 	printf("2) Remover item\n");
 	printf("3) Listar itens\n");
 	printf("4) Buscar sequencial\n");
+	printf("5) Busca por hash\n");
+	printf("6) Estatisticas do pool de nos\n");
+	printf("7) Buscar por prefixo ou intervalo de nomes (sequencial)\n");
+	printf("8) Autocompletar nomes (arvore radix)\n");
+	printf("9) Buscar lote de nomes de um arquivo (threads)\n");
 	printf("0) Voltar\n");
 	printf("Escolha: ");
 	if (scanf("%d", &opcao) != 1) {
@@ -407,347 +1709,5156 @@ int menuLista(void) {
 	return opcao;
 }
 
-/* Inserção no fim do vetor; invalida ordenação para forçar reordenação antes da binária. */
-int inserirItemVetor(Item mochila[], int *tamanho, const char *nome, const char *tipo, int quantidade, int *ordenado) {
-	if (*tamanho >= CAPACIDADE_MAXIMA) {
-		printf("Mochila cheia (%d itens).\n", CAPACIDADE_MAXIMA);
+/* Garante espaço para ao menos 'minimo' elementos, dobrando a capacidade (custo amortizado O(1)). */
+static int crescerBuffer(void **dados, int *capacidade, int minimo, size_t tamanhoElemento) {
+	if (minimo <= *capacidade) {
+		return 1;
+	}
+	int novaCapacidade = *capacidade > 0 ? *capacidade : CAPACIDADE_INICIAL;
+	while (novaCapacidade < minimo) {
+		novaCapacidade = novaCapacidade > 0x3fffffff ? minimo : novaCapacidade * 2;
+	}
+	void *novo = realloc(*dados, (size_t)novaCapacidade * tamanhoElemento);
+	if (!novo) {
+		avisar("Falha ao alocar memoria.\n");
 		return 0;
 	}
+	*dados = novo;
+	*capacidade = novaCapacidade;
+	return 1;
+}
+
+/* Reduz a capacidade ao tamanho em uso (libera tudo se vazio). */
+static void ajustarBuffer(void **dados, int *capacidade, int tamanho, size_t tamanhoElemento) {
+	if (tamanho == 0) {
+		free(*dados);
+		*dados = NULL;
+		*capacidade = 0;
+		return;
+	}
+	if (tamanho == *capacidade) {
+		return;
+	}
+	void *novo = realloc(*dados, (size_t)tamanho * tamanhoElemento);
+	if (novo) {
+		*dados = novo;
+		*capacidade = tamanho;
+	}
+}
+
+/* Reserva capacidade antecipada para evitar realocações em cargas grandes. */
+int reservarVetor(VetorItens *mochila, int capacidade) {
+	return crescerBuffer((void **)&mochila->itens, &mochila->capacidade, capacidade, sizeof(Item));
+}
+
+/* Shrink-to-fit: devolve ao sistema a capacidade ociosa. */
+void compactarVetor(VetorItens *mochila) {
+	ajustarBuffer((void **)&mochila->itens, &mochila->capacidade, mochila->tamanho, sizeof(Item));
+}
+
+void liberarVetor(VetorItens *mochila) {
+	liberarHash(&mochila->indice);
+	liberarRadix(&mochila->radix);
+	liberarEytzinger(&mochila->eytzinger);
+	free(mochila->itens);
+	mochila->itens = NULL;
+	mochila->tamanho = 0;
+	mochila->capacidade = 0;
+}
+
+int reservarComponentes(VetorComponentes *torre, int capacidade) {
+	return crescerBuffer((void **)&torre->itens, &torre->capacidade, capacidade, sizeof(Componente));
+}
+
+void compactarComponentes(VetorComponentes *torre) {
+	ajustarBuffer((void **)&torre->itens, &torre->capacidade, torre->total, sizeof(Componente));
+}
+
+void liberarComponentes(VetorComponentes *torre) {
+	for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+		free(torre->visoes[c]);
+		torre->visoes[c] = NULL;
+		torre->visaoValida[c] = 0;
+	}
+	free(torre->itens);
+	torre->itens = NULL;
+	torre->total = 0;
+	torre->capacidade = 0;
+	liberarRadix(&torre->radix);
+	liberarEytzinger(&torre->eytzinger);
+}
+
+/* Inserção no fim do vetor; invalida ordenação para forçar reordenação antes da binária.
+ * No modo "manter ordenado" com o vetor já ordenado, a busca binária acha a
+ * posição e um único memmove abre espaço, preservando a ordem. */
+int inserirItemVetor(VetorItens *mochila, const char *nome, const char *tipo, int quantidade, int *ordenado) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
 	if (quantidade <= 0) {
-		printf("Quantidade deve ser positiva.\n");
+		avisar("Quantidade deve ser positiva.\n");
+		return 0;
+	}
+	if (buscarHash(&mochila->indice, nome, NULL)) {
+		avisar("Item '%s' ja existe.\n", nome);
+		return 0;
+	}
+	int idTipo = internarTipo(tipo);
+	if (idTipo < 0 || !reservarVetor(mochila, mochila->tamanho + 1)) {
+		return 0;
+	}
+	if (!inserirRadix(&mochila->radix, nome, quantidade)) {
+		avisar("Falha ao alocar memoria.\n");
 		return 0;
 	}
-	strncpy(mochila[*tamanho].nome, nome, TAM_NOME - 1);
-	mochila[*tamanho].nome[TAM_NOME - 1] = '\0';
-	strncpy(mochila[*tamanho].tipo, tipo, TAM_TIPO - 1);
-	mochila[*tamanho].tipo[TAM_TIPO - 1] = '\0';
-	mochila[*tamanho].quantidade = quantidade;
-	(*tamanho)++;
-	*ordenado = 0;
+	int ordenada = mochila->manterOrdenado && *ordenado;
+	int pos = mochila->tamanho;
+	if (ordenada) {
+		long comparacoes = 0;
+		pos = limiteInferiorVetor(mochila->itens, mochila->tamanho, nome, &comparacoes);
+		memmove(&mochila->itens[pos + 1], &mochila->itens[pos], (size_t)(mochila->tamanho - pos) * sizeof(Item));
+		if (pos < mochila->tamanho) {
+			/* Anexar no fim não desloca ninguém; evita varrer o hash à toa. */
+			deslocarPosicoesHash(&mochila->indice, pos, 1);
+		}
+	}
+	Item *novo = &mochila->itens[pos];
+	strncpy(novo->nome, nome, TAM_NOME - 1);
+	novo->nome[TAM_NOME - 1] = '\0';
+	novo->tipo = (IdTipo)idTipo;
+	novo->quantidade = quantidade;
+	mochila->tamanho++;
+	mochila->versao++;
+	if (!inserirHash(&mochila->indice, novo->nome, pos, NULL)) {
+		/* Sem memória para o índice: desfaz a abertura de espaço. */
+		mochila->tamanho--;
+		memmove(&mochila->itens[pos], &mochila->itens[pos + 1], (size_t)(mochila->tamanho - pos) * sizeof(Item));
+		if (ordenada && pos < mochila->tamanho) {
+			deslocarPosicoesHash(&mochila->indice, pos + 1, -1);
+		}
+		removerRadix(&mochila->radix, nome);
+		return 0;
+	}
+	if (ordenada) {
+		mochila->reordenacoesEvitadas++;
+	} else {
+		*ordenado = 0;
+	}
+	registrarDiario(mochila->diario, DIARIO_VETOR_INSERIR, novo->nome, nomeTipo(novo->tipo), quantidade);
+	return 1;
+}
+
+/* Remove por nome deslocando elementos; também invalida a ordenação.
+ * A posição vem do índice hash e os itens deslocados têm o índice corrigido.
+ * No modo "manter ordenado" a posição vem da busca binária e a ordem fica. */
+int removerItemVetor(VetorItens *mochila, const char *nome, int *ordenado) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
+	int ordenada = mochila->manterOrdenado && *ordenado;
+	int idx;
+	if (ordenada) {
+		long comparacoes = 0;
+		idx = buscarBinariaVetor(mochila->itens, mochila->tamanho, nome, &comparacoes);
+	} else {
+		idx = buscarHashVetor(mochila, nome, NULL);
+	}
+	if (idx == -1) {
+		avisar("Item nao encontrado.\n");
+		return 0;
+	}
+	registrarDiario(mochila->diario, DIARIO_VETOR_REMOVER, mochila->itens[idx].nome, "", 0);
+	removerHash(&mochila->indice, mochila->itens[idx].nome);
+	removerRadix(&mochila->radix, mochila->itens[idx].nome);
+	memmove(&mochila->itens[idx], &mochila->itens[idx + 1], (size_t)(mochila->tamanho - idx - 1) * sizeof(Item));
+	mochila->tamanho--;
+	mochila->versao++;
+	if (idx < mochila->tamanho) {
+		deslocarPosicoesHash(&mochila->indice, idx, -1);
+	}
+	if (ordenada) {
+		mochila->reordenacoesEvitadas++;
+	} else {
+		*ordenado = 0;
+	}
 	return 1;
 }
 
-/* Remove por nome deslocando elementos; também invalida a ordenação. */
-int removerItemVetor(Item mochila[], int *tamanho, const char *nome, int *ordenado) {
-	int idx = -1;
-	for (int i = 0; i < *tamanho; i++) {
+/* Liga/desliga o modo "manter ordenado"; ao ligar, ordena uma última vez se preciso. */
+void definirManterOrdenado(VetorItens *mochila, int ativo, int *ordenado) {
+	mochila->manterOrdenado = ativo;
+	if (ativo && !*ordenado) {
+		long comparacoes = 0;
+		ordenarVetor(mochila, &comparacoes);
+		*ordenado = 1;
+	}
+}
+
+/* Exibe inventário armazenado no vetor. */
+void listarItensVetor(const VetorItens *mochila) {
+	printf("\nItens no vetor (%d/%d):\n", mochila->tamanho, mochila->capacidade);
+	if (mochila->tamanho == 0) {
+		printf("(vazio)\n");
+		return;
+	}
+	for (int i = 0; i < mochila->tamanho; i++) {
+		const Item *item = &mochila->itens[i];
+		printf("%d) %s | %s | qtd %d\n", i + 1, item->nome, nomeTipo(item->tipo), item->quantidade);
+	}
+}
+
+/* Busca sequencial no vetor com contador de comparações. */
+int buscarSequencialVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes) {
+	for (int i = 0; i < tamanho; i++) {
+		(*comparacoes)++;
 		if (strcmp(mochila[i].nome, nome) == 0) {
-			idx = i;
-			break;
+			return i;
 		}
 	}
-	if (idx == -1) {
-		printf("Item nao encontrado.\n");
+	return -1;
+}
+
+/* Bubble sort por nome para habilitar busca binária; reindexa o hash ao final.
+ * Para na primeira passada sem trocas, e sem nenhuma troca o hash continua válido. */
+int ordenarVetor(VetorItens *vetor, long *comparacoes) {
+	Item *mochila = vetor->itens;
+	int tamanho = vetor->tamanho;
+	if (tamanho < 2) {
+		return 0;
+	}
+	int moveu = 0;
+	for (int i = 0; i < tamanho - 1; i++) {
+		int trocou = 0;
+		for (int j = 0; j < tamanho - i - 1; j++) {
+			(*comparacoes)++;
+			if (strcmp(mochila[j].nome, mochila[j + 1].nome) > 0) {
+				Item tmp = mochila[j];
+				trocasOrdenacao++;
+				mochila[j] = mochila[j + 1];
+				mochila[j + 1] = tmp;
+				trocou = 1;
+			}
+		}
+		if (!trocou) {
+			break;
+		}
+		moveu = 1;
+	}
+	if (!moveu) {
+		return 1;
+	}
+	reconstruirHashVetor(vetor);
+	vetor->versao++;
+	return 1;
+}
+
+/* Alternativa O(n log n) ao bubble sort: merge sort paralelo por nome com até
+ * 'threads' threads (contadores em ultimaOrdenacaoParalela). O hash é
+ * reindexado uma vez no fim, e só se algum item mudou de lugar. */
+int ordenarVetorParalelo(VetorItens *vetor, int threads, long *comparacoes) {
+	if (vetor->tamanho < 2) {
+		return 0;
+	}
+	long comparacoesOrdenacao = 0;
+	long movimentosAntes = trocasOrdenacao;
+	mergeSortItensParalelo(vetor->itens, vetor->tamanho, threads, &ultimaOrdenacaoParalela, &comparacoesOrdenacao);
+	*comparacoes += comparacoesOrdenacao;
+	if (trocasOrdenacao == movimentosAntes) {
+		return 1;
+	}
+	reconstruirHashVetor(vetor);
+	vetor->versao++;
+	return 1;
+}
+
+/* Primeira posição cujo nome não é menor que 'nome' (ponto de inserção). */
+int limiteInferiorVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes) {
+	int inicio = 0;
+	int fim = tamanho;
+	while (inicio < fim) {
+		int meio = inicio + (fim - inicio) / 2;
+		(*comparacoes)++;
+		if (strcmp(mochila[meio].nome, nome) < 0) {
+			inicio = meio + 1;
+		} else {
+			fim = meio;
+		}
+	}
+	return inicio;
+}
+
+/* Busca binária no vetor ordenado, contando comparações. */
+int buscarBinariaVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes) {
+	int inicio = 0;
+	int fim = tamanho - 1;
+	while (inicio <= fim) {
+		int meio = (inicio + fim) / 2;
+		(*comparacoes)++;
+		int cmp = strcmp(mochila[meio].nome, nome);
+		if (cmp == 0) {
+			return meio;
+		} else if (cmp < 0) {
+			inicio = meio + 1;
+		} else {
+			fim = meio - 1;
+		}
+	}
+	return -1;
+}
+
+/* Insere novo nó ao final da lista encadeada em O(1) via ponteiro de fim; recusa nomes duplicados. */
+int inserirItemLista(ListaItens *lista, const char *nome, const char *tipo, int quantidade) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
+	if (quantidade <= 0) {
+		avisar("Quantidade deve ser positiva.\n");
+		return 0;
+	}
+	if (buscarHash(&lista->indice, nome, NULL)) {
+		avisar("Item '%s' ja existe.\n", nome);
+		return 0;
+	}
+	int idTipo = internarTipo(tipo);
+	if (idTipo < 0) {
+		return 0;
+	}
+	No *novo = alocarNo(&lista->pool);
+	if (!novo || !inserirRadix(&lista->radix, nome, quantidade)) {
+		if (novo) {
+			devolverNo(&lista->pool, novo);
+		}
+		avisar("Falha ao alocar memoria.\n");
+		return 0;
+	}
+	strncpy(novo->dados.nome, nome, TAM_NOME - 1);
+	novo->dados.nome[TAM_NOME - 1] = '\0';
+	novo->dados.tipo = (IdTipo)idTipo;
+	novo->dados.quantidade = quantidade;
+	novo->proximo = NULL;
+	if (!inserirHash(&lista->indice, novo->dados.nome, -1, novo)) {
+		removerRadix(&lista->radix, novo->dados.nome);
+		devolverNo(&lista->pool, novo);
+		return 0;
+	}
+
+	if (lista->fim == NULL) {
+		lista->inicio = novo;
+	} else {
+		lista->fim->proximo = novo;
+	}
+	lista->fim = novo;
+	lista->tamanho++;
+	registrarDiario(lista->diario, DIARIO_LISTA_INSERIR, novo->dados.nome, nomeTipo(novo->dados.tipo), quantidade);
+	return 1;
+}
+
+/* Remove nó pelo nome ajustando encadeamento. O hash localiza o nó; se ele
+ * tiver sucessor, os dados do sucessor são copiados para ele e o sucessor é
+ * liberado (O(1)). Só o último nó exige percorrer a lista atrás do anterior. */
+int removerItemLista(ListaItens *lista, const char *nome) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
+	EntradaHash *entrada = buscarHash(&lista->indice, nome, NULL);
+	if (!entrada) {
+		avisar("Item nao encontrado.\n");
+		return 0;
+	}
+	No *alvo = entrada->no;
+	registrarDiario(lista->diario, DIARIO_LISTA_REMOVER, alvo->dados.nome, "", 0);
+	removerHash(&lista->indice, alvo->dados.nome);
+	removerRadix(&lista->radix, alvo->dados.nome);
+	if (alvo->proximo) {
+		No *sucessor = alvo->proximo;
+		alvo->dados = sucessor->dados;
+		alvo->proximo = sucessor->proximo;
+		buscarHash(&lista->indice, alvo->dados.nome, NULL)->no = alvo;
+		if (lista->fim == sucessor) {
+			lista->fim = alvo;
+		}
+		devolverNo(&lista->pool, sucessor);
+		lista->tamanho--;
+		return 1;
+	}
+	if (lista->inicio == alvo) {
+		lista->inicio = NULL;
+		lista->fim = NULL;
+	} else {
+		No *anterior = lista->inicio;
+		while (anterior->proximo != alvo) {
+			anterior = anterior->proximo;
+		}
+		anterior->proximo = NULL;
+		lista->fim = anterior;
+	}
+	devolverNo(&lista->pool, alvo);
+	lista->tamanho--;
+	return 1;
+}
+
+/* Percorre e exibe a lista encadeada. */
+void listarItensLista(const ListaItens *lista) {
+	const No *inicio = lista->inicio;
+	printf("\nItens na lista (%d):\n", lista->tamanho);
+	if (!inicio) {
+		printf("(vazio)\n");
+		return;
+	}
+	int idx = 1;
+	while (inicio) {
+		printf("%d) %s | %s | qtd %d\n", idx, inicio->dados.nome, nomeTipo(inicio->dados.tipo), inicio->dados.quantidade);
+		inicio = inicio->proximo;
+		idx++;
+	}
+}
+
+/* Busca sequencial na lista com contagem de comparações. */
+No *buscarSequencialLista(const No *inicio, const char *nome, long *comparacoes) {
+	while (inicio) {
+		(*comparacoes)++;
+		if (strcmp(inicio->dados.nome, nome) == 0) {
+			return (No *)inicio;
+		}
+		inicio = inicio->proximo;
+	}
+	return NULL;
+}
+
+/* Busca O(1) esperado pelo índice hash da lista. */
+No *buscarHashLista(const ListaItens *lista, const char *nome, long *sondagens) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
+	EntradaHash *entrada = buscarHash(&lista->indice, nome, sondagens);
+	return entrada ? entrada->no : NULL;
+}
+
+/* Libera todos os nós de uma vez devolvendo os blocos do pool (sem percorrer a lista). */
+void liberarLista(ListaItens *lista) {
+	liberarPool(&lista->pool);
+	lista->inicio = NULL;
+	lista->fim = NULL;
+	lista->tamanho = 0;
+	liberarHash(&lista->indice);
+	liberarRadix(&lista->radix);
+}
+
+/* Entrega um nó reciclado ou o próximo livre do bloco atual; só chama malloc
+ * quando o bloco se esgota, dobrando o tamanho do bloco seguinte. */
+No *alocarNo(PoolNos *pool) {
+	No *no;
+	if (pool->livres) {
+		no = pool->livres;
+		pool->livres = no->proximo;
+		pool->nosReciclados++;
+	} else {
+		if (!pool->blocos || pool->usadosNoBloco == pool->blocos->capacidade) {
+			int capacidade = pool->blocos ? pool->blocos->capacidade * 2 : NOS_BLOCO_INICIAL;
+			if (capacidade > NOS_BLOCO_MAXIMO) {
+				capacidade = NOS_BLOCO_MAXIMO;
+			}
+			BlocoNos *bloco = (BlocoNos *)malloc(sizeof(BlocoNos) + (size_t)capacidade * sizeof(No));
+			if (!bloco) {
+				return NULL;
+			}
+			bloco->capacidade = capacidade;
+			bloco->proximo = pool->blocos;
+			pool->blocos = bloco;
+			pool->usadosNoBloco = 0;
+			pool->blocosAlocados++;
+		}
+		no = &pool->blocos->nos[pool->usadosNoBloco++];
+	}
+	pool->nosEntregues++;
+	return no;
+}
+
+/* Devolve o nó à lista de livres para reaproveitamento pela próxima inserção. */
+void devolverNo(PoolNos *pool, No *no) {
+	no->proximo = pool->livres;
+	pool->livres = no;
+}
+
+void liberarPool(PoolNos *pool) {
+	BlocoNos *bloco = pool->blocos;
+	while (bloco) {
+		BlocoNos *prox = bloco->proximo;
+		free(bloco);
+		bloco = prox;
+	}
+	pool->blocos = NULL;
+	pool->usadosNoBloco = 0;
+	pool->livres = NULL;
+}
+
+/* Mostra quantos malloc/free o pool evitou em relação a um nó por alocação. */
+void mostrarEstatisticasPool(const PoolNos *pool) {
+	long capacidadeTotal = 0;
+	for (const BlocoNos *bloco = pool->blocos; bloco; bloco = bloco->proximo) {
+		capacidadeTotal += bloco->capacidade;
+	}
+	printf("Pool de nos: %ld blocos (%ld nos, %zu bytes)\n", pool->blocosAlocados, capacidadeTotal, (size_t)capacidadeTotal * sizeof(No));
+	printf("Nos entregues: %ld | reciclados: %ld | malloc evitados: %ld\n",
+		pool->nosEntregues, pool->nosReciclados, pool->nosEntregues - pool->blocosAlocados);
+}
+
+/* ========== ÍNDICE HASH POR NOME ========== */
+
+/* Copia o nome cortado em TAM_NOME-1 caracteres, como ele é guardado: o hash
+ * e o radix precisam ver a mesma chave na busca e na inserção. */
+const char *cortarNome(const char *nome, char chave[TAM_NOME]) {
+	size_t tamanho = strnlen(nome, TAM_NOME - 1);
+	memcpy(chave, nome, tamanho);
+	chave[tamanho] = '\0';
+	return chave;
+}
+
+/* FNV-1a de 32 bits: simples e com boa dispersão para nomes curtos. */
+unsigned int hashNome(const char *nome) {
+	unsigned int h = 2166136261u;
+	while (*nome) {
+		h ^= (unsigned char)*nome++;
+		h *= 16777619u;
+	}
+	return h;
+}
+
+/* Sondagem linear a partir do hash; conta cada posição inspecionada. */
+EntradaHash *buscarHash(const IndiceHash *indice, const char *nome, long *sondagens) {
+	if (indice->capacidade == 0) {
+		return NULL;
+	}
+	unsigned int h = hashNome(nome);
+	unsigned int mascara = (unsigned int)indice->capacidade - 1;
+	for (unsigned int i = h & mascara;; i = (i + 1) & mascara) {
+		EntradaHash *entrada = &indice->entradas[i];
+		if (sondagens) {
+			(*sondagens)++;
+		}
+		if (entrada->estado == HASH_VAZIO) {
+			return NULL;
+		}
+		if (entrada->estado == HASH_OCUPADO && entrada->hash == h && strncmp(entrada->nome, nome, TAM_NOME - 1) == 0) {
+			return entrada;
+		}
+	}
+}
+
+/* Realoca a tabela mantendo ocupação <= 50% e descartando marcas de remoção. */
+static int redimensionarHash(IndiceHash *indice, int minimo) {
+	int novaCapacidade = HASH_CAPACIDADE_INICIAL;
+	while (novaCapacidade < minimo * 2) {
+		novaCapacidade *= 2;
+	}
+	EntradaHash *novas = (EntradaHash *)calloc((size_t)novaCapacidade, sizeof(EntradaHash));
+	if (!novas) {
+		avisar("Falha ao alocar memoria.\n");
+		return 0;
+	}
+	unsigned int mascara = (unsigned int)novaCapacidade - 1;
+	for (int i = 0; i < indice->capacidade; i++) {
+		const EntradaHash *entrada = &indice->entradas[i];
+		if (entrada->estado != HASH_OCUPADO) {
+			continue;
+		}
+		unsigned int j = entrada->hash & mascara;
+		while (novas[j].estado != HASH_VAZIO) {
+			j = (j + 1) & mascara;
+		}
+		novas[j] = *entrada;
+	}
+	free(indice->entradas);
+	indice->entradas = novas;
+	indice->capacidade = novaCapacidade;
+	indice->removidos = 0;
+	return 1;
+}
+
+/* Insere a chave; retorna 0 se já existir ou faltar memória. */
+int inserirHash(IndiceHash *indice, const char *nome, int posicao, No *no) {
+	if ((indice->ocupados + indice->removidos + 1) * 10 > indice->capacidade * 7) {
+		if (!redimensionarHash(indice, indice->ocupados + 1)) {
+			return 0;
+		}
+	}
+	unsigned int h = hashNome(nome);
+	unsigned int mascara = (unsigned int)indice->capacidade - 1;
+	EntradaHash *livre = NULL;
+	for (unsigned int i = h & mascara;; i = (i + 1) & mascara) {
+		EntradaHash *entrada = &indice->entradas[i];
+		if (entrada->estado == HASH_VAZIO) {
+			if (!livre) {
+				livre = entrada;
+			}
+			break;
+		}
+		if (entrada->estado == HASH_REMOVIDO) {
+			if (!livre) {
+				livre = entrada;
+			}
+		} else if (entrada->hash == h && strncmp(entrada->nome, nome, TAM_NOME - 1) == 0) {
+			return 0;
+		}
+	}
+	if (livre->estado == HASH_REMOVIDO) {
+		indice->removidos--;
+	}
+	strncpy(livre->nome, nome, TAM_NOME - 1);
+	livre->nome[TAM_NOME - 1] = '\0';
+	livre->hash = h;
+	livre->estado = HASH_OCUPADO;
+	livre->posicao = posicao;
+	livre->no = no;
+	indice->ocupados++;
+	return 1;
+}
+
+/* Marca a entrada como removida (lápide) para não quebrar cadeias de sondagem. */
+int removerHash(IndiceHash *indice, const char *nome) {
+	EntradaHash *entrada = buscarHash(indice, nome, NULL);
+	if (!entrada) {
+		return 0;
+	}
+	entrada->estado = HASH_REMOVIDO;
+	indice->ocupados--;
+	indice->removidos++;
+	return 1;
+}
+
+/* Soma delta às posições >= aPartirDe após um deslocamento no vetor. */
+void deslocarPosicoesHash(IndiceHash *indice, int aPartirDe, int delta) {
+	for (int i = 0; i < indice->capacidade; i++) {
+		EntradaHash *entrada = &indice->entradas[i];
+		if (entrada->estado == HASH_OCUPADO && entrada->posicao >= aPartirDe) {
+			entrada->posicao += delta;
+		}
+	}
+}
+
+/* Refaz o índice do vetor do zero (usado após reordenações). */
+void reconstruirHashVetor(VetorItens *mochila) {
+	liberarHash(&mochila->indice);
+	if (mochila->tamanho == 0 || !redimensionarHash(&mochila->indice, mochila->tamanho)) {
+		return;
+	}
+	for (int i = 0; i < mochila->tamanho; i++) {
+		inserirHash(&mochila->indice, mochila->itens[i].nome, i, NULL);
+	}
+}
+
+void liberarHash(IndiceHash *indice) {
+	free(indice->entradas);
+	indice->entradas = NULL;
+	indice->capacidade = 0;
+	indice->ocupados = 0;
+	indice->removidos = 0;
+}
+
+/* Busca O(1) esperado pelo índice hash do vetor. */
+int buscarHashVetor(const VetorItens *mochila, const char *nome, long *sondagens) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
+	EntradaHash *entrada = buscarHash(&mochila->indice, nome, sondagens);
+	return entrada ? entrada->posicao : -1;
+}
+
+/* ========== ÁRVORE RADIX (AUTOCOMPLETAR) ========== */
+
+/* Reaproveita um nó da lista de livres ou cresce o vetor de nós; devolve o
+ * índice (ponteiros para 'nos' ficam inválidos após a chamada). */
+static int alocarNoRadix(ArvoreRadix *arvore) {
+	int indice;
+	if (arvore->livres) {
+		indice = arvore->livres;
+		arvore->livres = arvore->nos[indice].irmao;
+		arvore->nosLivres--;
+	} else {
+		if (!crescerBuffer((void **)&arvore->nos, &arvore->capacidadeNos, arvore->totalNos + 1, sizeof(NoRadix))) {
+			return -1;
+		}
+		indice = arvore->totalNos++;
+	}
+	memset(&arvore->nos[indice], 0, sizeof(NoRadix));
+	return indice;
+}
+
+static void devolverNoRadix(ArvoreRadix *arvore, int indice) {
+	NoRadix *no = &arvore->nos[indice];
+	arvore->arenaMorta += no->tamanho;
+	no->rotulo = -1;
+	no->tamanho = 0;
+	no->ocorrencias = 0;
+	no->filho = 0;
+	no->irmao = arvore->livres;
+	arvore->livres = indice;
+	arvore->nosLivres++;
+}
+
+/* Copia 'tamanho' caracteres para o fim da arena; devolve o deslocamento ou -1. */
+static int guardarRotulo(ArvoreRadix *arvore, const char *texto, int tamanho) {
+	if (!crescerBuffer((void **)&arvore->arena, &arvore->capacidadeArena, arvore->usadosArena + tamanho, 1)) {
+		return -1;
+	}
+	int deslocamento = arvore->usadosArena;
+	memcpy(&arvore->arena[deslocamento], texto, (size_t)tamanho);
+	arvore->usadosArena += tamanho;
+	return deslocamento;
+}
+
+/* Reescreve a arena só com os rótulos vivos quando o lixo passa da metade. */
+static void compactarArenaRadix(ArvoreRadix *arvore) {
+	if (arvore->arenaMorta < 1024 || arvore->arenaMorta * 2 < arvore->usadosArena) {
+		return;
+	}
+	int vivos = arvore->usadosArena - arvore->arenaMorta;
+	char *nova = (char *)malloc((size_t)(vivos > 0 ? vivos : 1));
+	if (!nova) {
+		return;
+	}
+	int usados = 0;
+	for (int i = 1; i < arvore->totalNos; i++) {
+		NoRadix *no = &arvore->nos[i];
+		if (no->rotulo < 0) {
+			continue;
+		}
+		memcpy(&nova[usados], &arvore->arena[no->rotulo], no->tamanho);
+		no->rotulo = usados;
+		usados += no->tamanho;
+	}
+	free(arvore->arena);
+	arvore->arena = nova;
+	arvore->usadosArena = usados;
+	arvore->capacidadeArena = vivos > 0 ? vivos : 1;
+	arvore->arenaMorta = 0;
+}
+
+/* Filho de 'pai' cujo rótulo começa por 'c'; 'anterior' recebe o irmão que o precede. */
+static int filhoRadix(const ArvoreRadix *arvore, int pai, char c, int *anterior) {
+	int ant = 0;
+	int atual = arvore->nos[pai].filho;
+	while (atual && (unsigned char)arvore->arena[arvore->nos[atual].rotulo] < (unsigned char)c) {
+		ant = atual;
+		atual = arvore->nos[atual].irmao;
+	}
+	if (anterior) {
+		*anterior = ant;
+	}
+	if (atual && arvore->arena[arvore->nos[atual].rotulo] == c) {
+		return atual;
+	}
+	return 0;
+}
+
+/* Insere 'nome' (truncado como nos registros) com o peso dado. Um nome que já
+ * existe soma uma ocorrência e fica com o maior peso. */
+int inserirRadix(ArvoreRadix *arvore, const char *nome, int peso) {
+	if (arvore->totalNos == 0 && alocarNoRadix(arvore) != 0) {
+		return 0;
+	}
+	size_t restante = strlen(nome);
+	if (restante > TAM_NOME - 1) {
+		restante = TAM_NOME - 1;
+	}
+	int atual = 0;
+	while (restante > 0) {
+		int anterior;
+		int filho = filhoRadix(arvore, atual, *nome, &anterior);
+		if (!filho) {
+			int rotulo = guardarRotulo(arvore, nome, (int)restante);
+			int folha = rotulo < 0 ? -1 : alocarNoRadix(arvore);
+			if (folha < 0) {
+				return 0;
+			}
+			NoRadix *novo = &arvore->nos[folha];
+			novo->rotulo = rotulo;
+			novo->tamanho = (unsigned char)restante;
+			novo->ocorrencias = 1;
+			novo->peso = peso;
+			novo->irmao = anterior ? arvore->nos[anterior].irmao : arvore->nos[atual].filho;
+			if (anterior) {
+				arvore->nos[anterior].irmao = folha;
+			} else {
+				arvore->nos[atual].filho = folha;
+			}
+			arvore->nomes++;
+			return 1;
+		}
+		const char *rotulo = &arvore->arena[arvore->nos[filho].rotulo];
+		int tamanho = arvore->nos[filho].tamanho;
+		int comum = 1;
+		while (comum < tamanho && (size_t)comum < restante && rotulo[comum] == nome[comum]) {
+			comum++;
+		}
+		if (comum < tamanho) {
+			/* Divide o rótulo: o meio herda o começo e o filho fica com o resto. */
+			int meio = alocarNoRadix(arvore);
+			if (meio < 0) {
+				return 0;
+			}
+			NoRadix *no = &arvore->nos[filho];
+			NoRadix *novo = &arvore->nos[meio];
+			novo->rotulo = no->rotulo;
+			novo->tamanho = (unsigned char)comum;
+			novo->filho = filho;
+			novo->irmao = no->irmao;
+			no->rotulo += comum;
+			no->tamanho = (unsigned char)(no->tamanho - comum);
+			no->irmao = 0;
+			if (anterior) {
+				arvore->nos[anterior].irmao = meio;
+			} else {
+				arvore->nos[atual].filho = meio;
+			}
+			filho = meio;
+		}
+		atual = filho;
+		nome += comum;
+		restante -= (size_t)comum;
+	}
+	NoRadix *fim = &arvore->nos[atual];
+	if (fim->ocorrencias == 0) {
+		arvore->nomes++;
+		fim->peso = peso;
+	} else if (peso > fim->peso) {
+		fim->peso = peso;
+	}
+	fim->ocorrencias++;
+	return 1;
+}
+
+/* Funde 'no' (interno, sem ocorrências) com seu único filho. Se os rótulos já
+ * são vizinhos na arena (caso de uma divisão anterior) não copia nada. */
+static void fundirRadix(ArvoreRadix *arvore, int no) {
+	NoRadix *pai = &arvore->nos[no];
+	int unico = pai->filho;
+	NoRadix *filho = &arvore->nos[unico];
+	int tamanho = pai->tamanho + filho->tamanho;
+	int rotulo;
+	if (pai->rotulo + pai->tamanho == filho->rotulo) {
+		rotulo = pai->rotulo;
+	} else {
+		char junto[TAM_NOME];
+		memcpy(junto, &arvore->arena[pai->rotulo], pai->tamanho);
+		memcpy(&junto[pai->tamanho], &arvore->arena[filho->rotulo], filho->tamanho);
+		rotulo = guardarRotulo(arvore, junto, tamanho);
+		if (rotulo < 0) {
+			return; /* sem memória: a árvore só fica menos compacta */
+		}
+		pai = &arvore->nos[no];
+		filho = &arvore->nos[unico];
+		arvore->arenaMorta += tamanho;
+	}
+	pai->rotulo = rotulo;
+	pai->tamanho = (unsigned char)tamanho;
+	pai->ocorrencias = filho->ocorrencias;
+	pai->peso = filho->peso;
+	pai->filho = filho->filho;
+	filho->tamanho = 0; /* o rótulo passou ao pai; não conta como lixo */
+	devolverNoRadix(arvore, unico);
+}
+
+/* Retira uma ocorrência de 'nome'; remove folhas vazias e refaz a compressão. */
+int removerRadix(ArvoreRadix *arvore, const char *nome) {
+	if (arvore->totalNos == 0) {
+		return 0;
+	}
+	size_t restante = strlen(nome);
+	if (restante > TAM_NOME - 1) {
+		restante = TAM_NOME - 1;
+	}
+	int pai = 0;
+	int anterior = 0;
+	int atual = 0;
+	while (restante > 0) {
+		int ant;
+		int filho = filhoRadix(arvore, atual, *nome, &ant);
+		if (!filho) {
+			return 0;
+		}
+		int tamanho = arvore->nos[filho].tamanho;
+		if ((size_t)tamanho > restante || memcmp(&arvore->arena[arvore->nos[filho].rotulo], nome, (size_t)tamanho) != 0) {
+			return 0;
+		}
+		pai = atual;
+		anterior = ant;
+		atual = filho;
+		nome += tamanho;
+		restante -= (size_t)tamanho;
+	}
+	NoRadix *no = &arvore->nos[atual];
+	if (no->ocorrencias == 0) {
+		return 0;
+	}
+	if (--no->ocorrencias > 0) {
+		return 1;
+	}
+	arvore->nomes--;
+	if (atual == 0) {
+		return 1; /* nome vazio: a ocorrência fica na raiz, que nunca sai */
+	}
+	if (no->filho == 0) {
+		if (anterior) {
+			arvore->nos[anterior].irmao = no->irmao;
+		} else {
+			arvore->nos[pai].filho = no->irmao;
+		}
+		devolverNoRadix(arvore, atual);
+		NoRadix *acima = &arvore->nos[pai];
+		if (pai != 0 && acima->ocorrencias == 0 && acima->filho && arvore->nos[acima->filho].irmao == 0) {
+			fundirRadix(arvore, pai);
+		}
+	} else if (arvore->nos[no->filho].irmao == 0) {
+		fundirRadix(arvore, atual);
+	}
+	compactarArenaRadix(arvore);
+	return 1;
+}
+
+/* Desce pelo prefixo e devolve o nó cuja subárvore contém todos os nomes que o
+ * começam (0 com 'achou' = 0 quando nenhum). 'consumido' recebe quantos
+ * caracteres do rótulo do nó final já pertencem ao prefixo. */
+static int descerRadix(const ArvoreRadix *arvore, const char *prefixo, int *consumido, int *achou, long *nosVisitados) {
+	*achou = 0;
+	*consumido = 0;
+	if (arvore->totalNos == 0) {
+		return 0;
+	}
+	size_t restante = strlen(prefixo);
+	int atual = 0;
+	while (restante > 0) {
+		int filho = filhoRadix(arvore, atual, *prefixo, NULL);
+		(*nosVisitados)++;
+		if (!filho) {
+			return 0;
+		}
+		const NoRadix *no = &arvore->nos[filho];
+		size_t usar = restante < no->tamanho ? restante : no->tamanho;
+		if (memcmp(&arvore->arena[no->rotulo], prefixo, usar) != 0) {
+			return 0;
+		}
+		atual = filho;
+		prefixo += usar;
+		restante -= usar;
+		*consumido = (int)usar;
+	}
+	*achou = 1;
+	return atual;
+}
+
+/* Busca exata: 1 se o nome existe (peso em *peso quando não nulo). */
+int buscarRadix(const ArvoreRadix *arvore, const char *nome, int *peso, long *nosVisitados) {
+	int consumido;
+	int achou;
+	int no = descerRadix(arvore, nome, &consumido, &achou, nosVisitados);
+	if (!achou || no == 0 || consumido != arvore->nos[no].tamanho || arvore->nos[no].ocorrencias == 0) {
+		return 0;
+	}
+	if (peso) {
+		*peso = arvore->nos[no].peso;
+	}
+	return 1;
+}
+
+/* Estado do percurso em profundidade que reconstrói os nomes. */
+typedef struct {
+	const ArvoreRadix *arvore;
+	char nome[TAM_NOME];
+	SugestaoRadix *sugestoes;
+	int maximo;
+	int preenchidas;
+	int porPeso;
+	long encontrados;
+	long *nosVisitados;
+} PercursoRadix;
+
+/* Em ordem alfabética guarda os primeiros 'maximo' e para; por peso mantém os
+ * 'maximo' maiores em ordem decrescente (empates ficam em ordem alfabética). */
+static int percorrerRadix(PercursoRadix *percurso, int no, int profundidade) {
+	const NoRadix *atual = &percurso->arvore->nos[no];
+	(*percurso->nosVisitados)++;
+	if (atual->ocorrencias > 0) {
+		percurso->encontrados++;
+		percurso->nome[profundidade] = '\0';
+		int pos = percurso->preenchidas;
+		if (percurso->porPeso) {
+			while (pos > 0 && percurso->sugestoes[pos - 1].peso < atual->peso) {
+				pos--;
+			}
+		}
+		if (pos < percurso->maximo) {
+			int ultimo = percurso->preenchidas < percurso->maximo ? percurso->preenchidas : percurso->maximo - 1;
+			memmove(&percurso->sugestoes[pos + 1], &percurso->sugestoes[pos], (size_t)(ultimo - pos) * sizeof(SugestaoRadix));
+			strcpy(percurso->sugestoes[pos].nome, percurso->nome);
+			percurso->sugestoes[pos].peso = atual->peso;
+			if (percurso->preenchidas < percurso->maximo) {
+				percurso->preenchidas++;
+			}
+		}
+		if (!percurso->porPeso && percurso->preenchidas == percurso->maximo) {
+			return 0;
+		}
+	}
+	for (int filho = atual->filho; filho; filho = percurso->arvore->nos[filho].irmao) {
+		const NoRadix *f = &percurso->arvore->nos[filho];
+		memcpy(&percurso->nome[profundidade], &percurso->arvore->arena[f->rotulo], f->tamanho);
+		if (!percorrerRadix(percurso, filho, profundidade + f->tamanho)) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Autocompletar: até 'maximo' nomes começados por 'prefixo', em ordem
+ * alfabética (para ao preencher) ou os de maior peso (percorre a subárvore).
+ * Devolve quantas sugestões foram preenchidas; *encontrados recebe quantos
+ * nomes foram vistos no percurso. */
+int completarRadix(const ArvoreRadix *arvore, const char *prefixo, int porPeso, SugestaoRadix sugestoes[], int maximo, long *encontrados, long *nosVisitados) {
+	int consumido;
+	int achou;
+	*encontrados = 0;
+	int no = descerRadix(arvore, prefixo, &consumido, &achou, nosVisitados);
+	if (!achou || maximo <= 0) {
+		return 0;
+	}
+	PercursoRadix percurso = {0};
+	percurso.arvore = arvore;
+	percurso.sugestoes = sugestoes;
+	percurso.maximo = maximo;
+	percurso.porPeso = porPeso;
+	percurso.nosVisitados = nosVisitados;
+	/* O caminho até o nó é o prefixo mais o resto do rótulo ainda não digitado. */
+	size_t tamanhoPrefixo = strlen(prefixo);
+	if (tamanhoPrefixo > TAM_NOME - 1) {
+		return 0;
+	}
+	memcpy(percurso.nome, prefixo, tamanhoPrefixo);
+	int profundidade = (int)tamanhoPrefixo;
+	if (no != 0) {
+		const NoRadix *atual = &arvore->nos[no];
+		int resto = atual->tamanho - consumido;
+		memcpy(&percurso.nome[profundidade], &arvore->arena[atual->rotulo + consumido], (size_t)resto);
+		profundidade += resto;
+	}
+	percorrerRadix(&percurso, no, profundidade);
+	*encontrados = percurso.encontrados;
+	return percurso.preenchidas;
+}
+
+/* Memória da árvore ao lado do índice hash (se houver) e do texto puro dos nomes. */
+void mostrarMemoriaRadix(const ArvoreRadix *arvore, const IndiceHash *indice) {
+	size_t bytesNos = (size_t)arvore->capacidadeNos * sizeof(NoRadix);
+	size_t bytesArena = (size_t)arvore->capacidadeArena;
+	printf("Arvore radix: %d nomes | %d nos ativos (%d livres, %zu bytes cada)\n",
+		arvore->nomes, arvore->totalNos - arvore->nosLivres, arvore->nosLivres, sizeof(NoRadix));
+	printf("Arena de rotulos: %d bytes usados (%d mortos) de %d | total %.1f KiB\n",
+		arvore->usadosArena, arvore->arenaMorta, arvore->capacidadeArena, (double)(bytesNos + bytesArena) / 1024.0);
+	if (indice) {
+		printf("Indice hash (so busca exata): %.1f KiB\n", (double)((size_t)indice->capacidade * sizeof(EntradaHash)) / 1024.0);
+	}
+	printf("Nomes em texto fixo (%d bytes cada): %.1f KiB\n", TAM_NOME, (double)arvore->nomes * TAM_NOME / 1024.0);
+}
+
+void liberarRadix(ArvoreRadix *arvore) {
+	free(arvore->nos);
+	free(arvore->arena);
+	memset(arvore, 0, sizeof(*arvore));
+}
+
+/* Consulta da árvore medida em menuRadix: busca exata ou autocompletar. */
+typedef struct {
+	const ArvoreRadix *arvore;
+	const char *texto;
+	int porPeso;
+	SugestaoRadix *sugestoes;
+	long encontrados;
+	int peso;
+	int resultado; /* achou (busca exata) ou total de sugestões */
+	long nosVisitados;
+} ConsultaRadix;
+
+static void zerarConsultaRadix(void *contexto) {
+	((ConsultaRadix *)contexto)->nosVisitados = 0;
+}
+
+static void buscarRadixMedido(void *contexto) {
+	ConsultaRadix *consulta = (ConsultaRadix *)contexto;
+	consulta->resultado = buscarRadix(consulta->arvore, consulta->texto, &consulta->peso, &consulta->nosVisitados);
+}
+
+static void completarRadixMedido(void *contexto) {
+	ConsultaRadix *consulta = (ConsultaRadix *)contexto;
+	consulta->resultado = completarRadix(consulta->arvore, consulta->texto, consulta->porPeso, consulta->sugestoes, MAX_SUGESTOES,
+		&consulta->encontrados, &consulta->nosVisitados);
+}
+
+/* Submenu comum às três estruturas: exata, autocompletar, top-k e memória. */
+void menuRadix(const ArvoreRadix *arvore, const IndiceHash *indice, const char *rotuloPeso) {
+	int opcao;
+	printf("1) Busca exata  2) Autocompletar (alfabetica)  3) Top-%d por %s  4) Memoria: ", MAX_SUGESTOES, rotuloPeso);
+	if (scanf("%d", &opcao) != 1) {
+		opcao = 0;
+	}
+	limparBufferEntrada();
+	if (opcao == 4) {
+		mostrarMemoriaRadix(arvore, indice);
+		return;
+	}
+	if (opcao < 1 || opcao > 3) {
+		printf("Opcao invalida.\n");
+		return;
+	}
+	char texto[TAM_NOME];
+	printf(opcao == 1 ? "Nome: " : "Prefixo: ");
+	lerLinha(texto, sizeof(texto));
+	SugestaoRadix sugestoes[MAX_SUGESTOES];
+	ConsultaRadix consulta;
+	memset(&consulta, 0, sizeof(consulta));
+	consulta.arvore = arvore;
+	consulta.texto = texto;
+	consulta.porPeso = opcao == 3;
+	consulta.sugestoes = sugestoes;
+	EstatisticasTempo tempo = medirRepetido(repeticoesMedicao, zerarConsultaRadix,
+		opcao == 1 ? buscarRadixMedido : completarRadixMedido, &consulta);
+	if (opcao == 1) {
+		if (consulta.resultado) {
+			printf("Encontrado: %s | %s %d\n", texto, rotuloPeso, consulta.peso);
+		} else {
+			printf("Nome nao encontrado.\n");
+		}
+	} else {
+		if (consulta.resultado == 0) {
+			printf("Nenhum nome comeca com '%s'.\n", texto);
+		}
+		for (int i = 0; i < consulta.resultado; i++) {
+			printf("  %s | %s %d\n", sugestoes[i].nome, rotuloPeso, sugestoes[i].peso);
+		}
+		if (opcao == 3 && consulta.encontrados > consulta.resultado) {
+			printf("  (%ld nomes com o prefixo)\n", consulta.encontrados);
+		}
+	}
+	printf("Nos visitados: %ld | ", consulta.nosVisitados);
+	imprimirTempo(&tempo);
+}
+
+/* ========== TABELA DE TIPOS (INTERNAMENTO) ========== */
+
+/* Devolve o id do tipo ou -1 se ainda não foi internado. */
+int buscarTipo(const char *tipo) {
+	char chave[TAM_TIPO];
+	strncpy(chave, tipo, TAM_TIPO - 1);
+	chave[TAM_TIPO - 1] = '\0';
+	if (tabelaTipos.capacidadeHash == 0) {
+		return -1;
+	}
+	unsigned int mascara = (unsigned int)tabelaTipos.capacidadeHash - 1;
+	unsigned int j = hashNome(chave) & mascara;
+	while (tabelaTipos.hash[j] >= 0) {
+		if (strcmp(tabelaTipos.nomes[tabelaTipos.hash[j]], chave) == 0) {
+			return tabelaTipos.hash[j];
+		}
+		j = (j + 1) & mascara;
+	}
+	return -1;
+}
+
+/* Reconstroi o hash de ids com o dobro de posições (sempre potência de 2). */
+static int crescerHashTipos(void) {
+	int novaCapacidade = tabelaTipos.capacidadeHash ? tabelaTipos.capacidadeHash * 2 : 16;
+	int *novo = (int *)malloc((size_t)novaCapacidade * sizeof(int));
+	if (!novo) {
+		return 0;
+	}
+	memset(novo, -1, (size_t)novaCapacidade * sizeof(int));
+	unsigned int mascara = (unsigned int)novaCapacidade - 1;
+	for (int id = 0; id < tabelaTipos.total; id++) {
+		unsigned int j = hashNome(tabelaTipos.nomes[id]) & mascara;
+		while (novo[j] >= 0) {
+			j = (j + 1) & mascara;
+		}
+		novo[j] = id;
+	}
+	free(tabelaTipos.hash);
+	tabelaTipos.hash = novo;
+	tabelaTipos.capacidadeHash = novaCapacidade;
+	return 1;
+}
+
+/* Id do tipo, criando a entrada na primeira ocorrência; -1 se a tabela
+ * estiver cheia ou faltar memória. Um tipo novo entra no posto alfabético
+ * e empurra os maiores uma posição (k pequeno, O(k)). */
+int internarTipo(const char *tipo) {
+	int id = buscarTipo(tipo);
+	if (id >= 0) {
+		return id;
+	}
+	if (tabelaTipos.total >= MAX_TIPOS) {
+		avisar("Limite de %d tipos distintos atingido.\n", MAX_TIPOS);
+		return -1;
+	}
+	if ((tabelaTipos.total + 1) * 2 > tabelaTipos.capacidadeHash && !crescerHashTipos()) {
+		avisar("Falha ao alocar memoria.\n");
+		return -1;
+	}
+	if (tabelaTipos.total == tabelaTipos.capacidade) {
+		int novaCapacidade = tabelaTipos.capacidade ? tabelaTipos.capacidade * 2 : 8;
+		if (novaCapacidade > MAX_TIPOS) {
+			novaCapacidade = MAX_TIPOS;
+		}
+		char (*nomes)[TAM_TIPO] = realloc(tabelaTipos.nomes, (size_t)novaCapacidade * sizeof(*nomes));
+		if (nomes) tabelaTipos.nomes = nomes;
+		IdTipo *posto = (IdTipo *)realloc(tabelaTipos.posto, (size_t)novaCapacidade * sizeof(*posto));
+		if (posto) tabelaTipos.posto = posto;
+		if (!nomes || !posto) {
+			avisar("Falha ao alocar memoria.\n");
+			return -1;
+		}
+		tabelaTipos.capacidade = novaCapacidade;
+	}
+	id = tabelaTipos.total++;
+	strncpy(tabelaTipos.nomes[id], tipo, TAM_TIPO - 1);
+	tabelaTipos.nomes[id][TAM_TIPO - 1] = '\0';
+	int posto = 0;
+	for (int outro = 0; outro < id; outro++) {
+		if (strcmp(tabelaTipos.nomes[outro], tabelaTipos.nomes[id]) < 0) {
+			posto++;
+		} else {
+			tabelaTipos.posto[outro]++;
+		}
+	}
+	tabelaTipos.posto[id] = (IdTipo)posto;
+	unsigned int mascara = (unsigned int)tabelaTipos.capacidadeHash - 1;
+	unsigned int j = hashNome(tabelaTipos.nomes[id]) & mascara;
+	while (tabelaTipos.hash[j] >= 0) {
+		j = (j + 1) & mascara;
+	}
+	tabelaTipos.hash[j] = id;
+	return id;
+}
+
+const char *nomeTipo(IdTipo id) {
+	return id < tabelaTipos.total ? tabelaTipos.nomes[id] : "?";
+}
+
+/* Ordem alfabética dos tipos por comparação de inteiros (posto). */
+int compararTipos(IdTipo a, IdTipo b) {
+	return (int)tabelaTipos.posto[a] - (int)tabelaTipos.posto[b];
+}
+
+/* Bytes abaixo de 1 KiB, KiB acima. */
+static void formatarBytes(char destino[], size_t tamanho, double bytes) {
+	if (bytes < 1024.0) {
+		snprintf(destino, tamanho, "%.0f bytes", bytes);
+	} else {
+		snprintf(destino, tamanho, "%.1f KiB", bytes / 1024.0);
+	}
+}
+
+/* Quanto o id de 2 bytes economiza frente a guardar tipo[TAM_TIPO] em cada
+ * registro, e o custo fixo da tabela, mostrados à parte: com poucos registros
+ * a tabela custa mais do que eles economizam. */
+void mostrarMemoriaTipos(long registros) {
+	typedef struct {
+		char nome[TAM_NOME];
+		char tipo[TAM_TIPO];
+		int quantidade;
+	} RegistroTextual;
+	size_t tabela = (size_t)tabelaTipos.capacidade * (TAM_TIPO + sizeof(IdTipo)) + (size_t)tabelaTipos.capacidadeHash * sizeof(int);
+	char economia[32];
+	char custoTabela[32];
+	formatarBytes(economia, sizeof(economia), (double)registros * (double)(sizeof(RegistroTextual) - sizeof(Item)));
+	formatarBytes(custoTabela, sizeof(custoTabela), (double)tabela);
+	printf("Tipos internados: %d | Registro: %u bytes (texto: %u) | %ld registros economizam %s | tabela de tipos custa %s\n",
+		tabelaTipos.total, (unsigned)sizeof(Item), (unsigned)sizeof(RegistroTextual), registros, economia, custoTabela);
+}
+
+void liberarTabelaTipos(void) {
+	free(tabelaTipos.nomes);
+	free(tabelaTipos.posto);
+	free(tabelaTipos.hash);
+	memset(&tabelaTipos, 0, sizeof(tabelaTipos));
+}
+
+/* ========== LISTA DESENROLADA (UNROLLED) ========== */
+
+/* Menu da lista desenrolada, espelhando as operações da lista encadeada. */
+int menuListaDesenrolada(void) {
+	int opcao;
+	printf("\n--- Mochila (lista desenrolada, %d itens por no) ---\n", ITENS_POR_BLOCO);
+	printf("1) Inserir item\n");
+	printf("2) Remover item\n");
+	printf("3) Listar itens\n");
+	printf("4) Buscar sequencial\n");
+	printf("0) Voltar\n");
+	printf("Escolha: ");
+	if (scanf("%d", &opcao) != 1) {
+		opcao = 0;
+	}
+	limparBufferEntrada();
+	return opcao;
+}
+
+/* Acrescenta no último nó enquanto houver espaço; senão encadeia um nó novo.
+ * Sem índice hash, a recusa de nomes duplicados é uma varredura sequencial. */
+int inserirItemDesenrolada(ListaDesenrolada *lista, const char *nome, const char *tipo, int quantidade) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
+	if (quantidade <= 0) {
+		avisar("Quantidade deve ser positiva.\n");
+		return 0;
+	}
+	long comparacoes = 0;
+	long nosVisitados = 0;
+	if (buscarSequencialDesenrolada(lista, nome, &comparacoes, &nosVisitados)) {
+		avisar("Item '%s' ja existe.\n", nome);
+		return 0;
+	}
+	int idTipo = internarTipo(tipo);
+	if (idTipo < 0) {
+		return 0;
+	}
+	if (!lista->fim || lista->fim->usados == ITENS_POR_BLOCO) {
+		NoDesenrolado *novo = (NoDesenrolado *)malloc(sizeof(NoDesenrolado));
+		if (!novo) {
+			avisar("Falha ao alocar memoria.\n");
+			return 0;
+		}
+		novo->usados = 0;
+		novo->proximo = NULL;
+		if (lista->fim) {
+			lista->fim->proximo = novo;
+		} else {
+			lista->inicio = novo;
+		}
+		lista->fim = novo;
+		lista->nos++;
+	}
+	Item *item = &lista->fim->itens[lista->fim->usados++];
+	strcpy(item->nome, nome); /* já cortado em TAM_NOME-1 */
+	item->tipo = (IdTipo)idTipo;
+	item->quantidade = quantidade;
+	lista->tamanho++;
+	return 1;
+}
+
+/* Remove deslocando dentro do nó. Nó vazio é desencadeado; nó com menos da
+ * metade absorve o seguinte quando cabem juntos, mantendo a ocupação alta. */
+int removerItemDesenrolada(ListaDesenrolada *lista, const char *nome) {
+	char chave[TAM_NOME];
+	nome = cortarNome(nome, chave);
+	NoDesenrolado *anterior = NULL;
+	for (NoDesenrolado *no = lista->inicio; no; anterior = no, no = no->proximo) {
+		for (int i = 0; i < no->usados; i++) {
+			if (strcmp(no->itens[i].nome, nome) != 0) {
+				continue;
+			}
+			memmove(&no->itens[i], &no->itens[i + 1], (size_t)(no->usados - i - 1) * sizeof(Item));
+			no->usados--;
+			lista->tamanho--;
+			if (no->usados == 0) {
+				if (anterior) {
+					anterior->proximo = no->proximo;
+				} else {
+					lista->inicio = no->proximo;
+				}
+				if (lista->fim == no) {
+					lista->fim = anterior;
+				}
+				free(no);
+				lista->nos--;
+			} else if (no->usados < ITENS_POR_BLOCO / 2 && no->proximo && no->usados + no->proximo->usados <= ITENS_POR_BLOCO) {
+				NoDesenrolado *seguinte = no->proximo;
+				memcpy(&no->itens[no->usados], seguinte->itens, (size_t)seguinte->usados * sizeof(Item));
+				no->usados += seguinte->usados;
+				no->proximo = seguinte->proximo;
+				if (lista->fim == seguinte) {
+					lista->fim = no;
+				}
+				free(seguinte);
+				lista->nos--;
+			}
+			return 1;
+		}
+	}
+	avisar("Item nao encontrado.\n");
+	return 0;
+}
+
+void listarItensDesenrolada(const ListaDesenrolada *lista) {
+	printf("\nItens na lista desenrolada (%d em %d nos):\n", lista->tamanho, lista->nos);
+	if (!lista->inicio) {
+		printf("(vazio)\n");
+		return;
+	}
+	int idx = 1;
+	for (const NoDesenrolado *no = lista->inicio; no; no = no->proximo) {
+		for (int i = 0; i < no->usados; i++) {
+			printf("%d) %s | %s | qtd %d\n", idx++, no->itens[i].nome, nomeTipo(no->itens[i].tipo), no->itens[i].quantidade);
+		}
+	}
+}
+
+/* Busca sequencial contando comparações e nós visitados: a diferença para a
+ * lista clássica (um nó por comparação) isola o custo do layout de memória. */
+Item *buscarSequencialDesenrolada(const ListaDesenrolada *lista, const char *nome, long *comparacoes, long *nosVisitados) {
+	for (const NoDesenrolado *no = lista->inicio; no; no = no->proximo) {
+		(*nosVisitados)++;
+		for (int i = 0; i < no->usados; i++) {
+			(*comparacoes)++;
+			if (strcmp(no->itens[i].nome, nome) == 0) {
+				return (Item *)&no->itens[i];
+			}
+		}
+	}
+	return NULL;
+}
+
+void liberarListaDesenrolada(ListaDesenrolada *lista) {
+	NoDesenrolado *no = lista->inicio;
+	while (no) {
+		NoDesenrolado *prox = no->proximo;
+		free(no);
+		no = prox;
+	}
+	lista->inicio = NULL;
+	lista->fim = NULL;
+	lista->tamanho = 0;
+	lista->nos = 0;
+}
+
+/* ========== MEDIÇÃO DE TEMPO ========== */
+
+/* Relógio monotônico em nanossegundos (clock_gettime, não o clock() de CPU). */
+long long agoraNs(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compararAmostras(const void *a, const void *b) {
+	long long x = *(const long long *)a;
+	long long y = *(const long long *)b;
+	return (x > y) - (x < y);
+}
+
+/* Ordena as amostras e extrai mínimo, mediana e percentil 99 (nearest-rank). */
+void resumirAmostras(long long amostras[], int total, EstatisticasTempo *estatisticas) {
+	qsort(amostras, (size_t)total, sizeof(long long), compararAmostras);
+	int indiceP99 = (int)((total * 99 + 99) / 100) - 1;
+	estatisticas->amostras = total;
+	estatisticas->minimo = amostras[0];
+	estatisticas->mediana = amostras[total / 2];
+	estatisticas->p99 = amostras[indiceP99 < 0 ? 0 : indiceP99];
+}
+
+/* Operação medida uma única vez. */
+void resumirAmostraUnica(EstatisticasTempo *estatisticas, long long amostra) {
+	resumirAmostras(&amostra, 1, estatisticas);
+}
+
+/* Mede 'operacao' 'repeticoes' vezes com o relógio monotônico; 'preparo'
+ * (opcional) roda antes de cada medição sem entrar no tempo. Sem memória
+ * para as amostras, mede uma vez só. */
+EstatisticasTempo medirRepetido(int repeticoes, OperacaoMedida preparo, OperacaoMedida operacao, void *contexto) {
+	long long amostraUnica;
+	long long *amostras = repeticoes > 1 ? (long long *)malloc((size_t)repeticoes * sizeof(long long)) : NULL;
+	if (!amostras) {
+		amostras = &amostraUnica;
+		repeticoes = 1;
+	}
+	for (int r = 0; r < repeticoes; r++) {
+		if (preparo) {
+			preparo(contexto);
+		}
+		long long inicio = agoraNs();
+		operacao(contexto);
+		amostras[r] = agoraNs() - inicio;
+	}
+	EstatisticasTempo estatisticas;
+	resumirAmostras(amostras, repeticoes, &estatisticas);
+	if (amostras != &amostraUnica) {
+		free(amostras);
+	}
+	return estatisticas;
+}
+
+static void zerarConsulta(void *contexto) {
+	ConsultaMedida *consulta = (ConsultaMedida *)contexto;
+	consulta->contador = 0;
+	consulta->nosVisitados = 0;
+}
+
+static void repetirConsulta(void *contexto) {
+	ConsultaMedida *consulta = (ConsultaMedida *)contexto;
+	consulta->executar(consulta);
+}
+
+/* Consulta com os resultados zerados; 'chave' e 'argumento' conforme 'executar'. */
+ConsultaMedida novaConsulta(void (*executar)(ConsultaMedida *consulta), void *estrutura, const void *chave, int argumento) {
+	ConsultaMedida consulta;
+	memset(&consulta, 0, sizeof(consulta));
+	consulta.executar = executar;
+	consulta.estrutura = estrutura;
+	consulta.chave = chave;
+	consulta.argumento = argumento;
+	consulta.resultado = -1;
+	return consulta;
+}
+
+/* Mede a consulta repeticoesMedicao vezes; o resultado é o da última. */
+EstatisticasTempo medirConsulta(ConsultaMedida *consulta) {
+	return medirRepetido(repeticoesMedicao, zerarConsulta, repetirConsulta, consulta);
+}
+
+/* Consultas dos menus: cada uma chama a busca da estrutura com os campos de 'consulta'. */
+void executarBuscaSequencialVetor(ConsultaMedida *consulta) {
+	const VetorItens *mochila = (const VetorItens *)consulta->estrutura;
+	consulta->resultado = buscarSequencialVetor(mochila->itens, mochila->tamanho, (const char *)consulta->chave, &consulta->contador);
+}
+
+void executarBuscaBinariaVetor(ConsultaMedida *consulta) {
+	const VetorItens *mochila = (const VetorItens *)consulta->estrutura;
+	consulta->resultado = buscarBinariaVetor(mochila->itens, mochila->tamanho, (const char *)consulta->chave, &consulta->contador);
+}
+
+void executarBuscaHashVetor(ConsultaMedida *consulta) {
+	consulta->resultado = buscarHashVetor((const VetorItens *)consulta->estrutura, (const char *)consulta->chave, &consulta->contador);
+}
+
+void executarFaixaVetor(ConsultaMedida *consulta) {
+	const VetorItens *mochila = (const VetorItens *)consulta->estrutura;
+	consulta->resultado = buscarFaixaVetor(mochila->itens, mochila->tamanho, *(const FaixaNomes *)consulta->chave, &consulta->inicio, &consulta->contador);
+}
+
+void executarBuscaEytzinger(ConsultaMedida *consulta) {
+	consulta->resultado = buscarEytzinger((const IndiceEytzinger *)consulta->estrutura, (const char *)consulta->chave, &consulta->contador);
+}
+
+void executarBuscaSequencialLista(ConsultaMedida *consulta) {
+	const No *achado = buscarSequencialLista(((const ListaItens *)consulta->estrutura)->inicio, (const char *)consulta->chave, &consulta->contador);
+	consulta->achado = achado;
+	consulta->resultado = achado != NULL;
+}
+
+void executarBuscaHashLista(ConsultaMedida *consulta) {
+	const No *achado = buscarHashLista((const ListaItens *)consulta->estrutura, (const char *)consulta->chave, &consulta->contador);
+	consulta->achado = achado;
+	consulta->resultado = achado != NULL;
+}
+
+void executarFaixaLista(ConsultaMedida *consulta) {
+	consulta->resultado = buscarFaixaLista(((const ListaItens *)consulta->estrutura)->inicio, *(const FaixaNomes *)consulta->chave,
+		consulta->nos, MAX_FAIXA_EXIBIDA, &consulta->contador);
+}
+
+void executarBuscaDesenrolada(ConsultaMedida *consulta) {
+	const Item *achado = buscarSequencialDesenrolada((const ListaDesenrolada *)consulta->estrutura, (const char *)consulta->chave,
+		&consulta->contador, &consulta->nosVisitados);
+	consulta->achado = achado;
+	consulta->resultado = achado != NULL;
+}
+
+/* Torre ordenada por nome: binária direta; senão, pela visão por nome (que já deve existir). */
+void executarBuscaBinariaTorre(ConsultaMedida *consulta) {
+	VetorComponentes *torre = (VetorComponentes *)consulta->estrutura;
+	consulta->resultado = consulta->argumento
+		? buscaBinariaPorNome(torre->itens, torre->total, (const char *)consulta->chave, &consulta->contador)
+		: buscaBinariaVisaoNome(torre, (const char *)consulta->chave, &consulta->contador);
+}
+
+void executarOrdenarVisao(ConsultaMedida *consulta) {
+	consulta->resultado = ordenarVisao((VetorComponentes *)consulta->estrutura, (Criterio)consulta->argumento, &consulta->contador);
+}
+
+void executarConsultaTipoPrioridade(ConsultaMedida *consulta) {
+	consulta->resultado = consultarTipoPrioridade((VetorComponentes *)consulta->estrutura, (const char *)consulta->chave,
+		consulta->argumento, &consulta->indices, &consulta->contador);
+}
+
+void executarFaixaTorre(ConsultaMedida *consulta) {
+	consulta->resultado = buscarFaixaTorre((VetorComponentes *)consulta->estrutura, *(const FaixaNomes *)consulta->chave,
+		&consulta->indices, &consulta->contador);
+}
+
+/* Ordenação de componentes medida com medirRepetido: cada repetição parte da
+ * mesma entrada, copiada de 'original' (se houver) fora do tempo. Sem
+ * 'algoritmo', usa o merge sort com 'comparar' (paralelo se threads > 0). */
+typedef struct {
+	Componente *componentes;
+	const Componente *original;
+	int total;
+	void (*algoritmo)(Componente[], int, long *);
+	ComparadorComponente comparar;
+	int threads;
+	EstatisticasParalelo *estatisticas;
+	long *comparacoes;
+} OrdenacaoMedida;
+
+static void restaurarOrdenacao(void *contexto) {
+	OrdenacaoMedida *ordenacao = (OrdenacaoMedida *)contexto;
+	if (ordenacao->original) {
+		memcpy(ordenacao->componentes, ordenacao->original, (size_t)ordenacao->total * sizeof(Componente));
+	}
+	trocasOrdenacao = 0;
+}
+
+static void executarOrdenacao(void *contexto) {
+	OrdenacaoMedida *ordenacao = (OrdenacaoMedida *)contexto;
+	if (ordenacao->algoritmo) {
+		ordenacao->algoritmo(ordenacao->componentes, ordenacao->total, ordenacao->comparacoes);
+	} else if (ordenacao->threads > 0) {
+		mergeSortParalelo(ordenacao->componentes, ordenacao->total, ordenacao->comparar, ordenacao->threads,
+			ordenacao->estatisticas, ordenacao->comparacoes);
+	} else {
+		mergeSortComponentes(ordenacao->componentes, ordenacao->total, ordenacao->comparar, ordenacao->comparacoes);
+	}
+}
+
+static EstatisticasTempo medirOrdenacao(OrdenacaoMedida *ordenacao, int repeticoes) {
+	return medirRepetido(repeticoes, restaurarOrdenacao, executarOrdenacao, ordenacao);
+}
+
+/* Cópia zerada de OrdenacaoMedida para 'componentes'; quem chama completa o algoritmo. */
+static OrdenacaoMedida novaOrdenacao(Componente componentes[], const Componente original[], int total, long *comparacoes) {
+	OrdenacaoMedida ordenacao;
+	memset(&ordenacao, 0, sizeof(ordenacao));
+	ordenacao.componentes = componentes;
+	ordenacao.original = original;
+	ordenacao.total = total;
+	ordenacao.comparacoes = comparacoes;
+	return ordenacao;
+}
+
+/* Uma amostra: só o valor; várias: mínimo, mediana e p99. */
+void imprimirTempo(const EstatisticasTempo *estatisticas) {
+	if (estatisticas->amostras <= 1) {
+		printf("Tempo: %lld ns\n", estatisticas->mediana);
+	} else {
+		printf("Tempo (%d repeticoes): min %lld | mediana %lld | p99 %lld ns\n",
+			estatisticas->amostras, estatisticas->minimo, estatisticas->mediana, estatisticas->p99);
+	}
+}
+
+/* Ajusta quantas vezes buscas e ordenações são repetidas para as estatísticas. */
+void configurarRepeticoes(void) {
+	int valor;
+	printf("Repeticoes por medicao (1-%d, atual %d): ", MAX_REPETICOES, repeticoesMedicao);
+	if (scanf("%d", &valor) != 1 || valor < 1 || valor > MAX_REPETICOES) {
+		printf("Valor invalido.\n");
+		limparBufferEntrada();
+		return;
+	}
+	limparBufferEntrada();
+	repeticoesMedicao = valor;
+	printf("Buscas e ordenacoes serao medidas %d vez(es); insercao e remocao alteram os dados e sao medidas uma vez.\n", valor);
+}
+
+/* ordenarVetorParalelo com as threads configuradas na torre (0 = todas as CPUs). */
+int ordenarVetorParaleloPadrao(VetorItens *mochila, long *comparacoes) {
+	return ordenarVetorParalelo(mochila, threadsOrdenacao > 0 ? threadsOrdenacao : threadsDisponiveis(), comparacoes);
+}
+
+/* Contexto de medirOrdenacaoVetor. */
+typedef struct {
+	OrdenacaoVetor ordenar;
+	VetorItens *mochila;
+	const Item *original;
+	long *comparacoes;
+	int *ordenou;
+} OrdenacaoVetorMedida;
+
+static void restaurarOrdenacaoVetor(void *contexto) {
+	OrdenacaoVetorMedida *ordenacao = (OrdenacaoVetorMedida *)contexto;
+	if (ordenacao->original) {
+		memcpy(ordenacao->mochila->itens, ordenacao->original, (size_t)ordenacao->mochila->tamanho * sizeof(Item));
+	}
+	*ordenacao->comparacoes = 0;
+}
+
+static void executarOrdenacaoVetor(void *contexto) {
+	OrdenacaoVetorMedida *ordenacao = (OrdenacaoVetorMedida *)contexto;
+	*ordenacao->ordenou = ordenacao->ordenar(ordenacao->mochila, ordenacao->comparacoes);
+}
+
+/* Ordenação do vetor medida com repetições: a entrada original é restaurada
+ * antes de cada rodada (fora do tempo) e a última deixa o vetor ordenado. */
+EstatisticasTempo medirOrdenacaoVetor(OrdenacaoVetor ordenar, VetorItens *mochila, long *comparacoes, int *ordenou) {
+	int repeticoes = repeticoesMedicao;
+	Item *original = NULL;
+	if (repeticoes > 1) {
+		original = (Item *)malloc((size_t)mochila->tamanho * sizeof(Item) + 1);
+		if (original) {
+			memcpy(original, mochila->itens, (size_t)mochila->tamanho * sizeof(Item));
+		} else {
+			repeticoes = 1;
+		}
+	}
+	OrdenacaoVetorMedida ordenacao = {ordenar, mochila, original, comparacoes, ordenou};
+	EstatisticasTempo estatisticas = medirRepetido(repeticoes, restaurarOrdenacaoVetor, executarOrdenacaoVetor, &ordenacao);
+	free(original);
+	return estatisticas;
+}
+
+/* ========== LAYOUT SoA (ESTRUTURA DE VETORES) ========== */
+
+/* Copia o vetor AoS para os vetores separados, só quando ele mudou desde a última cópia. */
+int sincronizarSoA(MochilaSoA *soa, const VetorItens *mochila) {
+	if (soa->sincronizado && soa->versao == mochila->versao) {
+		return 1;
+	}
+	if (mochila->tamanho > soa->capacidade) {
+		int capacidade = mochila->tamanho;
+		unsigned int *assinaturas = (unsigned int *)realloc(soa->assinaturas, (size_t)capacidade * sizeof(*assinaturas));
+		if (assinaturas) soa->assinaturas = assinaturas;
+		char (*nomes)[TAM_NOME] = realloc(soa->nomes, (size_t)capacidade * sizeof(*nomes));
+		if (nomes) soa->nomes = nomes;
+		IdTipo *tipos = (IdTipo *)realloc(soa->tipos, (size_t)capacidade * sizeof(*tipos));
+		if (tipos) soa->tipos = tipos;
+		int *quantidades = (int *)realloc(soa->quantidades, (size_t)capacidade * sizeof(*quantidades));
+		if (quantidades) soa->quantidades = quantidades;
+		if (!assinaturas || !nomes || !tipos || !quantidades) {
+			avisar("Falha ao alocar memoria.\n");
+			soa->sincronizado = 0;
+			return 0;
+		}
+		soa->capacidade = capacidade;
+	}
+	for (int i = 0; i < mochila->tamanho; i++) {
+		const Item *item = &mochila->itens[i];
+		soa->assinaturas[i] = hashNome(item->nome);
+		memcpy(soa->nomes[i], item->nome, TAM_NOME);
+		soa->tipos[i] = item->tipo;
+		soa->quantidades[i] = item->quantidade;
+	}
+	soa->tamanho = mochila->tamanho;
+	soa->versao = mochila->versao;
+	soa->sincronizado = 1;
+	return 1;
+}
+
+/* Confirma com strcmp o candidato cuja assinatura bateu. */
+static int confirmarSoA(const MochilaSoA *soa, int i, const char *nome, long *comparacoes) {
+	(*comparacoes)++;
+	return strcmp(soa->nomes[i], nome) == 0;
+}
+
+/* Busca sequencial que filtra pela assinatura de 32 bits do nome, vários
+ * itens por instrução (AVX2: 8, SSE2: 4), e só então confirma com strcmp.
+ * Uma assinatura (hash) discrimina melhor que um prefixo fixo, já que nomes
+ * como "Municao 9mm" e "Municao 5.56" dividem os primeiros bytes. */
+int buscarAssinaturaSoA(const MochilaSoA *soa, const char *nome, long *comparacoes) {
+	unsigned int chave = hashNome(nome);
+	int i = 0;
+#if defined(__AVX2__)
+	__m256i alvo = _mm256_set1_epi32((int)chave);
+	for (; i + 8 <= soa->tamanho; i += 8) {
+		__m256i bloco = _mm256_loadu_si256((const __m256i *)&soa->assinaturas[i]);
+		int mascara = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(bloco, alvo)));
+		while (mascara) {
+			int bit = __builtin_ctz((unsigned)mascara);
+			if (confirmarSoA(soa, i + bit, nome, comparacoes)) {
+				return i + bit;
+			}
+			mascara &= mascara - 1;
+		}
+	}
+#elif defined(__SSE2__)
+	__m128i alvo = _mm_set1_epi32((int)chave);
+	for (; i + 4 <= soa->tamanho; i += 4) {
+		__m128i bloco = _mm_loadu_si128((const __m128i *)&soa->assinaturas[i]);
+		int mascara = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(bloco, alvo)));
+		while (mascara) {
+			int bit = __builtin_ctz((unsigned)mascara);
+			if (confirmarSoA(soa, i + bit, nome, comparacoes)) {
+				return i + bit;
+			}
+			mascara &= mascara - 1;
+		}
+	}
+#endif
+	for (; i < soa->tamanho; i++) {
+		if (soa->assinaturas[i] == chave && confirmarSoA(soa, i, nome, comparacoes)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* Nome do caminho vetorizado escolhido na compilação. */
+const char *caminhoSimdSoA(void) {
+#if defined(__AVX2__)
+	return "AVX2 (8 assinaturas por instrucao)";
+#elif defined(__SSE2__)
+	return "SSE2 (4 assinaturas por instrucao)";
+#else
+	return "escalar";
+#endif
+}
+
+/* Mede ns/busca da varredura AoS (buscarSequencialVetor) contra a SoA filtrada. */
+void compararBuscaSoA(MochilaSoA *soa, const VetorItens *mochila, const char *nome) {
+	if (!sincronizarSoA(soa, mochila)) {
+		return;
+	}
+	int repeticoes = mochila->tamanho > 0 ? 10000000 / mochila->tamanho : 1;
+	if (repeticoes < 1) repeticoes = 1;
+	if (repeticoes > 10000) repeticoes = 10000;
+
+	long comparacoesAoS = 0;
+	int posAoS = -1;
+	double inicio = tempoMonotonico();
+	for (int r = 0; r < repeticoes; r++) {
+		comparacoesAoS = 0;
+		posAoS = buscarSequencialVetor(mochila->itens, mochila->tamanho, nome, &comparacoesAoS);
+	}
+	double nsAoS = (tempoMonotonico() - inicio) * 1e9 / repeticoes;
+
+	long comparacoesSoA = 0;
+	int posSoA = -1;
+	inicio = tempoMonotonico();
+	for (int r = 0; r < repeticoes; r++) {
+		comparacoesSoA = 0;
+		posSoA = buscarAssinaturaSoA(soa, nome, &comparacoesSoA);
+	}
+	double nsSoA = (tempoMonotonico() - inicio) * 1e9 / repeticoes;
+
+	printf("Caminho SIMD: %s | %d repeticoes\n", caminhoSimdSoA(), repeticoes);
+	printf("AoS sequencial: posicao %d | strcmp: %ld | %.1f ns/busca\n", posAoS + 1, comparacoesAoS, nsAoS);
+	printf("SoA assinatura: posicao %d | strcmp: %ld | %.1f ns/busca\n", posSoA + 1, comparacoesSoA, nsSoA);
+	if (nsSoA > 0) {
+		printf("Aceleracao: %.2fx\n", nsAoS / nsSoA);
+	}
+}
+
+void liberarSoA(MochilaSoA *soa) {
+	free(soa->assinaturas);
+	free(soa->nomes);
+	free(soa->tipos);
+	free(soa->quantidades);
+	memset(soa, 0, sizeof(*soa));
+}
+
+/* ========== MÓDULO TORRE DE FUGA ========== */
+
+/* Menu do módulo Torre de Fuga */
+int menuTorreFuga(void) {
+	int opcao;
+	printf("\n=== TORRE DE FUGA - DESAFIO FINAL ===\n");
+	printf("1) Cadastrar componentes\n");
+	printf("2) Ordenar por NOME (Bubble Sort)\n");
+	printf("3) Ordenar por TIPO (Insertion Sort)\n");
+	printf("4) Ordenar por PRIORIDADE (Selection Sort)\n");
+	printf("5) Buscar componente-chave (Busca Binaria)\n");
+	printf("6) Listar componentes\n");
+	printf("7) Ordenar com MERGE SORT (estavel, O(n log n))\n");
+	printf("8) Ordenar indices (visao indireta, sem mover dados)\n");
+	printf("9) Listar por visao indireta\n");
+	printf("10) Aplicar visao (reordenar fisicamente)\n");
+	printf("11) Consultar por tipo e prioridade minima (indice secundario)\n");
+	printf("12) Ordenar por CONTAGEM (prioridade ou tipo, O(n))\n");
+	printf("13) Buscar por prefixo ou intervalo de nomes (visao por nome)\n");
+	printf("14) Autocompletar nomes (arvore radix)\n");
+	printf("15) Ordenar com MERGE SORT PARALELO (pthreads)\n");
+	printf("16) Curva de speedup do merge sort paralelo (1..N threads)\n");
+	printf("17) Buscar lote de nomes de um arquivo (visao por nome)\n");
+	printf("18) Busca Eytzinger (layout BFS, sem desvios, prefetch) x binaria\n");
+	printf("0) Voltar\n");
+	printf("Escolha: ");
+	if (scanf("%d", &opcao) != 1) {
+		opcao = 0;
+	}
+	limparBufferEntrada();
+	return opcao;
+}
+
+/* Cadastra componentes da torre com nome, tipo e prioridade */
+void cadastrarComponentes(VetorComponentes *torre) {
+	int quantidade;
+	printf("\n>>> CADASTRO DE COMPONENTES <<<\n");
+	printf("Quantos componentes deseja cadastrar? ");
+	if (scanf("%d", &quantidade) != 1 || quantidade <= 0) {
+		printf("Quantidade invalida.\n");
+		limparBufferEntrada();
+		return;
+	}
+	limparBufferEntrada();
+	esvaziarTorre(torre);
+	if (!reservarComponentes(torre, quantidade)) {
+		return;
+	}
+	for (int i = 0; i < quantidade; i++) {
+		char nome[TAM_NOME];
+		char tipo[TAM_TIPO];
+		int prioridade;
+		printf("\n--- Componente %d ---\n", i + 1);
+		printf("Nome: ");
+		lerLinha(nome, sizeof(nome));
+		printf("Tipo (controle/suporte/propulsao): ");
+		lerLinha(tipo, sizeof(tipo));
+		printf("Prioridade (1-10): ");
+		if (scanf("%d", &prioridade) != 1) {
+			printf("Prioridade invalida, definindo como 1.\n");
+			prioridade = 1;
+		}
+		limparBufferEntrada();
+		adicionarComponente(torre, nome, tipo, prioridade);
+	}
+	printf("\n%d componentes cadastrados!\n", torre->total);
+}
+
+/* Descarta todos os componentes (o cadastro substitui a torre inteira). */
+void esvaziarTorre(VetorComponentes *torre) {
+	torre->total = 0;
+	invalidarVisoes(torre);
+	liberarRadix(&torre->radix);
+	registrarDiario(torre->diario, DIARIO_TORRE_LIMPAR, "", "", 0);
+}
+
+/* Acrescenta um componente ao fim da torre, limitando a prioridade a 1-10. */
+int adicionarComponente(VetorComponentes *torre, const char *nome, const char *tipo, int prioridade) {
+	int idTipo = internarTipo(tipo);
+	if (idTipo < 0 || !reservarComponentes(torre, torre->total + 1)) {
+		return 0;
+	}
+	if (prioridade < 1) prioridade = 1;
+	if (prioridade > 10) prioridade = 10;
+	if (!inserirRadix(&torre->radix, nome, prioridade)) {
+		avisar("Falha ao alocar memoria.\n");
+		return 0;
+	}
+	Componente *novo = &torre->itens[torre->total];
+	strncpy(novo->nome, nome, TAM_NOME - 1);
+	novo->nome[TAM_NOME - 1] = '\0';
+	novo->tipo = (IdTipo)idTipo;
+	novo->prioridade = prioridade;
+	torre->total++;
+	inserirNasVisoes(torre, torre->total - 1);
+	torre->eytzinger.sincronizado = 0;
+	registrarDiario(torre->diario, DIARIO_TORRE_INSERIR, novo->nome, nomeTipo(novo->tipo), prioridade);
+	return 1;
+}
+
+/* Bubble Sort: ordena componentes por NOME (ordem alfabética).
+ * Para na primeira passada sem trocas: entrada já ordenada custa n-1 comparações. */
+void bubbleSortNome(Componente componentes[], int total, long *comparacoes) {
+	*comparacoes = 0;
+	for (int i = 0; i < total - 1; i++) {
+		int trocou = 0;
+		for (int j = 0; j < total - i - 1; j++) {
+			(*comparacoes)++;
+			if (strcmp(componentes[j].nome, componentes[j + 1].nome) > 0) {
+				Componente temp = componentes[j];
+				trocasOrdenacao++;
+				componentes[j] = componentes[j + 1];
+				componentes[j + 1] = temp;
+				trocou = 1;
+			}
+		}
+		if (!trocou) {
+			break;
+		}
+	}
+}
+
+/* Insertion Sort: ordena componentes por TIPO (ordem alfabética) */
+void insertionSortTipo(Componente componentes[], int total, long *comparacoes) {
+	*comparacoes = 0;
+	for (int i = 1; i < total; i++) {
+		Componente chave = componentes[i];
+		int j = i - 1;
+		while (j >= 0) {
+			(*comparacoes)++;
+			if (compararTipos(componentes[j].tipo, chave.tipo) > 0) {
+				componentes[j + 1] = componentes[j];
+				trocasOrdenacao++;
+				j--;
+			} else {
+				break;
+			}
+		}
+		componentes[j + 1] = chave;
+	}
+}
+
+/* Selection Sort: ordena componentes por PRIORIDADE (ordem crescente) */
+void selectionSortPrioridade(Componente componentes[], int total, long *comparacoes) {
+	*comparacoes = 0;
+	for (int i = 0; i < total - 1; i++) {
+		int indiceMinimo = i;
+		for (int j = i + 1; j < total; j++) {
+			(*comparacoes)++;
+			if (componentes[j].prioridade < componentes[indiceMinimo].prioridade) {
+				indiceMinimo = j;
+			}
+		}
+		if (indiceMinimo != i) {
+			Componente temp = componentes[i];
+			trocasOrdenacao++;
+			componentes[i] = componentes[indiceMinimo];
+			componentes[indiceMinimo] = temp;
+		}
+	}
+}
+
+/* Critérios de comparação usados pelo Merge Sort. */
+int compararPorNome(const Componente *a, const Componente *b) {
+	return strcmp(a->nome, b->nome);
+}
+
+int compararPorTipo(const Componente *a, const Componente *b) {
+	return compararTipos(a->tipo, b->tipo);
+}
+
+int compararPorPrioridade(const Componente *a, const Componente *b) {
+	return (a->prioridade > b->prioridade) - (a->prioridade < b->prioridade);
+}
+
+/* Chave composta: prioridade decrescente, desempate por nome. */
+int compararPorPrioridadeDescNome(const Componente *a, const Componente *b) {
+	if (a->prioridade != b->prioridade) {
+		return (a->prioridade < b->prioridade) - (a->prioridade > b->prioridade);
+	}
+	return strcmp(a->nome, b->nome);
+}
+
+/* Chave composta: tipo, depois prioridade decrescente e nome. Agrupa cada tipo
+ * com os mais prioritários primeiro, o que torna contígua a faixa de
+ * "tipo == X e prioridade >= p". */
+int compararPorTipoPrioridadeDesc(const Componente *a, const Componente *b) {
+	int cmp = compararTipos(a->tipo, b->tipo);
+	if (cmp != 0) {
+		return cmp;
+	}
+	return compararPorPrioridadeDescNome(a, b);
+}
+
+/* Trechos pequenos vão para inserção direta, mais barata que intercalar;
+ * também é o tamanho mínimo de corrida no Merge Sort natural. */
+#define LIMIAR_INSERCAO 16
+
+/* Núcleo do Merge Sort natural, comum a componentes, itens da mochila e
+ * índices das visões: o vetor é visto como 'largura' bytes por elemento e
+ * comparado por uma função que recebe o contexto do chamador. */
+typedef int (*ComparadorSequencia)(const void *a, const void *b, const void *contexto);
+
+typedef struct {
+	unsigned char *dados;
+	size_t largura; /* bytes por elemento, no máximo sizeof(ElementoOrdenavel) */
+	ComparadorSequencia comparar;
+	const void *contexto;
+} Sequencia;
+
+/* Espaço para um elemento de qualquer tipo ordenado pelo núcleo (a chave da
+ * inserção e a troca das inversões), com o alinhamento de todos eles. */
+typedef union {
+	Componente componente;
+	Item item;
+	int indice;
+} ElementoOrdenavel;
+
+/* Contexto dos comparadores de componente; 'base' só nas visões por índice. */
+typedef struct {
+	ComparadorComponente comparar;
+	const Componente *base;
+} ContextoComponentes;
+
+#define ELEMENTO(dados, i, largura) ((dados) + (size_t)(i) * (largura))
+
+static int compararComponentesSequencia(const void *a, const void *b, const void *contexto) {
+	return ((const ContextoComponentes *)contexto)->comparar((const Componente *)a, (const Componente *)b);
+}
+
+static int compararIndicesSequencia(const void *a, const void *b, const void *contexto) {
+	const ContextoComponentes *componentes = (const ContextoComponentes *)contexto;
+	return componentes->comparar(&componentes->base[*(const int *)a], &componentes->base[*(const int *)b]);
+}
+
+/* O vetor da mochila só é ordenado por nome. */
+static int compararItensSequencia(const void *a, const void *b, const void *contexto) {
+	(void)contexto;
+	return strcmp(((const Item *)a)->nome, ((const Item *)b)->nome);
+}
+
+/* Inserção direta em [inicio, fim), sabendo que [inicio, ordenadosAte) já está em ordem. */
+static void insercaoIntervalo(const Sequencia *sequencia, int inicio, int ordenadosAte, int fim, long *comparacoes) {
+	unsigned char *dados = sequencia->dados;
+	size_t largura = sequencia->largura;
+	ElementoOrdenavel chave;
+	for (int i = ordenadosAte > inicio ? ordenadosAte : inicio + 1; i < fim; i++) {
+		memcpy(&chave, ELEMENTO(dados, i, largura), largura);
+		int j = i - 1;
+		while (j >= inicio) {
+			(*comparacoes)++;
+			if (sequencia->comparar(ELEMENTO(dados, j, largura), &chave, sequencia->contexto) > 0) {
+				memcpy(ELEMENTO(dados, j + 1, largura), ELEMENTO(dados, j, largura), largura);
+				trocasOrdenacao++;
+				j--;
+			} else {
+				break;
+			}
+		}
+		memcpy(ELEMENTO(dados, j + 1, largura), &chave, largura);
+	}
+}
+
+/* Intercala as corridas [inicio, meio) e [meio, fim) usando 'auxiliar'.
+ * Se a última da esquerda já não passa da primeira da direita, nada a fazer. */
+static void intercalarCorridas(const Sequencia *sequencia, unsigned char *auxiliar, int inicio, int meio, int fim, long *comparacoes) {
+	unsigned char *dados = sequencia->dados;
+	size_t largura = sequencia->largura;
+	(*comparacoes)++;
+	if (sequencia->comparar(ELEMENTO(dados, meio - 1, largura), ELEMENTO(dados, meio, largura), sequencia->contexto) <= 0) {
+		return;
+	}
+	memcpy(ELEMENTO(auxiliar, inicio, largura), ELEMENTO(dados, inicio, largura), (size_t)(meio - inicio) * largura);
+	int i = inicio;
+	int j = meio;
+	int k = inicio;
+	trocasOrdenacao += fim - inicio;
+	while (i < meio && j < fim) {
+		(*comparacoes)++;
+		/* '<=' mantém a estabilidade: em empate vence o elemento da esquerda. */
+		if (sequencia->comparar(ELEMENTO(auxiliar, i, largura), ELEMENTO(dados, j, largura), sequencia->contexto) <= 0) {
+			memcpy(ELEMENTO(dados, k++, largura), ELEMENTO(auxiliar, i++, largura), largura);
+		} else {
+			memcpy(ELEMENTO(dados, k++, largura), ELEMENTO(dados, j++, largura), largura);
+		}
+	}
+	memcpy(ELEMENTO(dados, k, largura), ELEMENTO(auxiliar, i, largura), (size_t)(meio - i) * largura);
+}
+
+/* Fim da corrida natural que começa em 'inicio'. Corridas estritamente
+ * decrescentes são invertidas no lugar (estrito preserva a estabilidade);
+ * corridas curtas são estendidas por inserção até LIMIAR_INSERCAO. */
+static int proximaCorrida(const Sequencia *sequencia, int inicio, int total, long *comparacoes) {
+	unsigned char *dados = sequencia->dados;
+	size_t largura = sequencia->largura;
+	int fim = inicio + 1;
+	if (fim < total) {
+		(*comparacoes)++;
+		if (sequencia->comparar(ELEMENTO(dados, inicio, largura), ELEMENTO(dados, fim, largura), sequencia->contexto) > 0) {
+			fim++;
+			while (fim < total) {
+				(*comparacoes)++;
+				if (sequencia->comparar(ELEMENTO(dados, fim - 1, largura), ELEMENTO(dados, fim, largura), sequencia->contexto) <= 0) {
+					break;
+				}
+				fim++;
+			}
+			ElementoOrdenavel temp;
+			for (int a = inicio, b = fim - 1; a < b; a++, b--) {
+				memcpy(&temp, ELEMENTO(dados, a, largura), largura);
+				memcpy(ELEMENTO(dados, a, largura), ELEMENTO(dados, b, largura), largura);
+				memcpy(ELEMENTO(dados, b, largura), &temp, largura);
+				trocasOrdenacao++;
+			}
+		} else {
+			fim++;
+			while (fim < total) {
+				(*comparacoes)++;
+				if (sequencia->comparar(ELEMENTO(dados, fim - 1, largura), ELEMENTO(dados, fim, largura), sequencia->contexto) > 0) {
+					break;
+				}
+				fim++;
+			}
+		}
+	}
+	int minimo = inicio + LIMIAR_INSERCAO < total ? inicio + LIMIAR_INSERCAO : total;
+	if (fim < minimo) {
+		insercaoIntervalo(sequencia, inicio, fim, minimo, comparacoes);
+		fim = minimo;
+	}
+	return fim;
+}
+
+/* Merge Sort natural e estável: aproveita as corridas já ordenadas da entrada
+ * e intercala corridas vizinhas até sobrar uma. Entrada já ordenada custa
+ * n-1 comparações e nenhuma alocação; o pior caso segue O(n log n).
+ * Devolve 0 se faltou memória (a entrada fica parcialmente ordenada). */
+static int ordenarSequencia(const Sequencia *sequencia, int total, long *comparacoes) {
+	*comparacoes = 0;
+	if (total < 2) {
+		return 1;
+	}
+	int *limites = (int *)malloc(((size_t)total / LIMIAR_INSERCAO + 2) * sizeof(int));
+	if (!limites) {
+		avisar("Falha ao alocar memoria.\n");
+		return 0;
+	}
+	int corridas = 0;
+	limites[0] = 0;
+	for (int inicio = 0; inicio < total; ) {
+		inicio = proximaCorrida(sequencia, inicio, total, comparacoes);
+		limites[++corridas] = inicio;
+	}
+	if (corridas > 1) {
+		unsigned char *auxiliar = (unsigned char *)malloc((size_t)total * sequencia->largura);
+		if (!auxiliar) {
+			avisar("Falha ao alocar memoria.\n");
+			free(limites);
+			return 0;
+		}
+		/* Passadas de baixo para cima: cada uma intercala pares de corridas vizinhas. */
+		while (corridas > 1) {
+			int novas = 0;
+			for (int r = 0; r < corridas; r += 2) {
+				if (r + 1 < corridas) {
+					intercalarCorridas(sequencia, auxiliar, limites[r], limites[r + 1], limites[r + 2], comparacoes);
+				}
+				limites[++novas] = limites[r + 2 < corridas ? r + 2 : corridas];
+			}
+			corridas = novas;
+		}
+		free(auxiliar);
+	}
+	free(limites);
+	return 1;
+}
+
+void mergeSortComponentes(Componente componentes[], int total, ComparadorComponente comparar, long *comparacoes) {
+	ContextoComponentes contexto = {comparar, NULL};
+	Sequencia sequencia = {(unsigned char *)componentes, sizeof(Componente), compararComponentesSequencia, &contexto};
+	ordenarSequencia(&sequencia, total, comparacoes);
+}
+
+/* Adaptadores com a assinatura esperada por medirTempoOrdenacao. */
+void mergeSortNome(Componente componentes[], int total, long *comparacoes) {
+	mergeSortComponentes(componentes, total, compararPorNome, comparacoes);
+}
+
+void mergeSortTipo(Componente componentes[], int total, long *comparacoes) {
+	mergeSortComponentes(componentes, total, compararPorTipo, comparacoes);
+}
+
+void mergeSortPrioridade(Componente componentes[], int total, long *comparacoes) {
+	mergeSortComponentes(componentes, total, compararPorPrioridade, comparacoes);
+}
+
+/* ========== MERGE SORT PARALELO (PTHREADS) ========== */
+
+/* Mesmo núcleo de ordenarSequencia: as corridas naturais são formadas
+ * pela thread principal e cada passada de baixo para cima reparte seus pares
+ * de corridas entre as threads. As intercalações de uma passada são
+ * independentes e idênticas às da versão sequencial, por isso a soma das
+ * comparações por thread é exatamente o total sequencial. */
+
+#define LIMIAR_PARALELO 4096 /* abaixo disso criar threads custa mais que ordenar */
+
+typedef struct {
+	pthread_mutex_t trava;
+	pthread_cond_t novaPassada;
+	pthread_cond_t passadaConcluida;
+	int geracao;
+	int encerrar;
+	int proximoPar;
+	int pares;
+	int lote;
+	int ativos; /* trabalhadores que ainda não terminaram a passada */
+	const Sequencia *sequencia;
+	unsigned char *auxiliar;
+	const int *limites;
+	ContadoresThread *contadores;
+} PassadaParalela;
+
+typedef struct {
+	PassadaParalela *passada;
+	int id;
+} TrabalhadorOrdenacao;
+
+/* Número de CPUs online, limitado a MAX_THREADS_ORDENACAO. */
+int threadsDisponiveis(void) {
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (cpus < 1) {
+		return 1;
+	}
+	return cpus > MAX_THREADS_ORDENACAO ? MAX_THREADS_ORDENACAO : (int)cpus;
+}
+
+/* Pega lotes de pares da passada atual até acabarem. */
+static void intercalarPares(PassadaParalela *passada, int id) {
+	ContadoresThread *meus = &passada->contadores[id];
+	for (;;) {
+		pthread_mutex_lock(&passada->trava);
+		int inicio = passada->proximoPar;
+		passada->proximoPar += passada->lote;
+		pthread_mutex_unlock(&passada->trava);
+		if (inicio >= passada->pares) {
+			return;
+		}
+		int fim = inicio + passada->lote < passada->pares ? inicio + passada->lote : passada->pares;
+		for (int par = inicio; par < fim; par++) {
+			const int *limites = &passada->limites[2 * par];
+			intercalarCorridas(passada->sequencia, passada->auxiliar, limites[0], limites[1], limites[2], &meus->comparacoes);
+			meus->intercalacoes++;
+		}
+	}
+}
+
+static void *trabalharOrdenacao(void *argumento) {
+	TrabalhadorOrdenacao *trabalhador = (TrabalhadorOrdenacao *)argumento;
+	PassadaParalela *passada = trabalhador->passada;
+	int vista = 0;
+	trocasOrdenacao = 0;
+	for (;;) {
+		pthread_mutex_lock(&passada->trava);
+		while (passada->geracao == vista && !passada->encerrar) {
+			pthread_cond_wait(&passada->novaPassada, &passada->trava);
+		}
+		if (passada->encerrar) {
+			pthread_mutex_unlock(&passada->trava);
+			break;
+		}
+		vista = passada->geracao;
+		pthread_mutex_unlock(&passada->trava);
+
+		intercalarPares(passada, trabalhador->id);
+
+		pthread_mutex_lock(&passada->trava);
+		if (--passada->ativos == 0) {
+			pthread_cond_signal(&passada->passadaConcluida);
+		}
+		pthread_mutex_unlock(&passada->trava);
+	}
+	passada->contadores[trabalhador->id].movimentos += trocasOrdenacao;
+	return NULL;
+}
+
+/* Ordena 'sequencia' com até 'threads' threads (a chamadora é a thread 0).
+ * Os contadores por thread vão para 'estatisticas' (opcional); *comparacoes
+ * recebe a soma. */
+static void ordenarSequenciaParalela(const Sequencia *sequencia, int total, int threads, EstatisticasParalelo *estatisticas, long *comparacoes) {
+	EstatisticasParalelo locais;
+	if (!estatisticas) {
+		estatisticas = &locais;
+	}
+	memset(estatisticas, 0, sizeof(*estatisticas));
+	if (threads < 1) {
+		threads = 1;
+	}
+	if (threads > MAX_THREADS_ORDENACAO) {
+		threads = MAX_THREADS_ORDENACAO;
+	}
+	if (total < LIMIAR_PARALELO) {
+		threads = 1;
+	}
+	estatisticas->threads = threads;
+	*comparacoes = 0;
+	if (total < 2) {
+		return;
+	}
+	ContadoresThread *principal = &estatisticas->porThread[0];
+	long movimentosAntes = trocasOrdenacao;
+	int *limites = (int *)malloc(((size_t)total / LIMIAR_INSERCAO + 2) * sizeof(int));
+	unsigned char *auxiliar = (unsigned char *)malloc((size_t)total * sequencia->largura);
+	if (!limites || !auxiliar) {
+		avisar("Falha ao alocar memoria.\n");
+		free(limites);
+		free(auxiliar);
+		return;
+	}
+	int corridas = 0;
+	limites[0] = 0;
+	for (int inicio = 0; inicio < total; ) {
+		inicio = proximaCorrida(sequencia, inicio, total, &principal->comparacoes);
+		limites[++corridas] = inicio;
+	}
+
+	PassadaParalela estado;
+	PassadaParalela *passada = &estado;
+	memset(passada, 0, sizeof(*passada));
+	pthread_mutex_init(&passada->trava, NULL);
+	pthread_cond_init(&passada->novaPassada, NULL);
+	pthread_cond_init(&passada->passadaConcluida, NULL);
+	passada->sequencia = sequencia;
+	passada->auxiliar = auxiliar;
+	passada->contadores = estatisticas->porThread;
+	pthread_t ids[MAX_THREADS_ORDENACAO];
+	TrabalhadorOrdenacao trabalhadores[MAX_THREADS_ORDENACAO];
+	int criadas = 1;
+	if (corridas > 2) {
+		for (; criadas < threads; criadas++) {
+			trabalhadores[criadas].passada = passada;
+			trabalhadores[criadas].id = criadas;
+			if (pthread_create(&ids[criadas], NULL, trabalharOrdenacao, &trabalhadores[criadas]) != 0) {
+				break; /* segue com as threads que conseguiu criar */
+			}
+		}
+	}
+	estatisticas->threads = criadas;
+
+	while (corridas > 1) {
+		int pares = corridas / 2;
+		pthread_mutex_lock(&passada->trava);
+		passada->limites = limites;
+		passada->pares = pares;
+		passada->proximoPar = 0;
+		passada->lote = pares / (criadas * 4) > 0 ? pares / (criadas * 4) : 1;
+		passada->ativos = pares > 1 ? criadas - 1 : 0;
+		if (passada->ativos > 0) {
+			passada->geracao++;
+			pthread_cond_broadcast(&passada->novaPassada);
+		}
+		pthread_mutex_unlock(&passada->trava);
+
+		intercalarPares(passada, 0);
+
+		pthread_mutex_lock(&passada->trava);
+		while (passada->ativos > 0) {
+			pthread_cond_wait(&passada->passadaConcluida, &passada->trava);
+		}
+		pthread_mutex_unlock(&passada->trava);
+
+		int novas = 0;
+		for (int r = 0; r < corridas; r += 2) {
+			limites[++novas] = limites[r + 2 < corridas ? r + 2 : corridas];
+		}
+		corridas = novas;
+	}
+
+	pthread_mutex_lock(&passada->trava);
+	passada->encerrar = 1;
+	pthread_cond_broadcast(&passada->novaPassada);
+	pthread_mutex_unlock(&passada->trava);
+	for (int t = 1; t < criadas; t++) {
+		pthread_join(ids[t], NULL);
+	}
+	pthread_cond_destroy(&passada->passadaConcluida);
+	pthread_cond_destroy(&passada->novaPassada);
+	pthread_mutex_destroy(&passada->trava);
+	free(auxiliar);
+	free(limites);
+
+	principal->movimentos += trocasOrdenacao - movimentosAntes;
+	long movimentos = 0;
+	for (int t = 0; t < criadas; t++) {
+		*comparacoes += estatisticas->porThread[t].comparacoes;
+		movimentos += estatisticas->porThread[t].movimentos;
+	}
+	/* Quem mede lê trocasOrdenacao da thread chamadora: inclui o que os trabalhadores moveram. */
+	trocasOrdenacao = movimentosAntes + movimentos;
+}
+
+/* Ordena os componentes com até 'threads' threads (a chamadora é a thread 0). */
+void mergeSortParalelo(Componente componentes[], int total, ComparadorComponente comparar, int threads, EstatisticasParalelo *estatisticas, long *comparacoes) {
+	ContextoComponentes contexto = {comparar, NULL};
+	Sequencia sequencia = {(unsigned char *)componentes, sizeof(Componente), compararComponentesSequencia, &contexto};
+	ordenarSequenciaParalela(&sequencia, total, threads, estatisticas, comparacoes);
+}
+
+/* O mesmo para os itens da mochila, por nome. */
+void mergeSortItensParalelo(Item itens[], int total, int threads, EstatisticasParalelo *estatisticas, long *comparacoes) {
+	Sequencia sequencia = {(unsigned char *)itens, sizeof(Item), compararItensSequencia, NULL};
+	ordenarSequenciaParalela(&sequencia, total, threads, estatisticas, comparacoes);
+}
+
+static void mergeSortParaleloCom(Componente componentes[], int total, ComparadorComponente comparar, long *comparacoes) {
+	int threads = threadsOrdenacao > 0 ? threadsOrdenacao : threadsDisponiveis();
+	mergeSortParalelo(componentes, total, comparar, threads, &ultimaOrdenacaoParalela, comparacoes);
+}
+
+/* Adaptadores com a assinatura esperada por medirTempoOrdenacao. */
+void mergeSortParaleloNome(Componente componentes[], int total, long *comparacoes) {
+	mergeSortParaleloCom(componentes, total, compararPorNome, comparacoes);
+}
+
+void mergeSortParaleloTipo(Componente componentes[], int total, long *comparacoes) {
+	mergeSortParaleloCom(componentes, total, compararPorTipo, comparacoes);
+}
+
+void mergeSortParaleloPrioridade(Componente componentes[], int total, long *comparacoes) {
+	mergeSortParaleloCom(componentes, total, compararPorPrioridade, comparacoes);
+}
+
+/* Tabela por thread da última ordenação paralela. */
+void mostrarEstatisticasParalelo(const EstatisticasParalelo *estatisticas) {
+	long comparacoes = 0;
+	long movimentos = 0;
+	printf("Thread | Comparacoes | Movimentos | Intercalacoes\n");
+	for (int t = 0; t < estatisticas->threads; t++) {
+		const ContadoresThread *c = &estatisticas->porThread[t];
+		printf("%6d | %11ld | %10ld | %13ld%s\n", t, c->comparacoes, c->movimentos, c->intercalacoes, t == 0 ? " (inclui corridas)" : "");
+		comparacoes += c->comparacoes;
+		movimentos += c->movimentos;
+	}
+	printf(" Soma  | %11ld | %10ld |\n", comparacoes, movimentos);
+}
+
+/* Mede a versão paralela com 1, 2, 4, ... até 'maximo' threads sobre cópias
+ * de 'componentes' (que não é alterado) e compara com a sequencial. */
+void curvaSpeedup(const Componente componentes[], int total, ComparadorComponente comparar, int maximo) {
+	Componente *trabalho = (Componente *)malloc((size_t)total * sizeof(Componente) + 1);
+	if (!trabalho) {
+		avisar("Falha ao alocar memoria.\n");
+		return;
+	}
+	long comparacoesSequencial = 0;
+	OrdenacaoMedida ordenacao = novaOrdenacao(trabalho, componentes, total, &comparacoesSequencial);
+	ordenacao.comparar = comparar;
+	EstatisticasTempo tempo = medirOrdenacao(&ordenacao, repeticoesMedicao);
+	printf("Sequencial (mergeSortComponentes): %lld ns | %ld comparacoes\n", tempo.mediana, comparacoesSequencial);
+	if (total < LIMIAR_PARALELO) {
+		printf("(com menos de %d componentes a versao paralela usa 1 thread)\n", LIMIAR_PARALELO);
+		maximo = 1;
+	}
+	printf("Threads | Mediana (ns) | Speedup | Eficiencia | Comparacoes\n");
+	long long umaThread = 0;
+	for (int t = 1; t <= maximo; t = t < maximo && t * 2 > maximo ? maximo : t * 2) {
+		EstatisticasParalelo estatisticas;
+		long comparacoes = 0;
+		ordenacao.comparacoes = &comparacoes;
+		ordenacao.threads = t;
+		ordenacao.estatisticas = &estatisticas;
+		tempo = medirOrdenacao(&ordenacao, repeticoesMedicao);
+		if (t == 1) {
+			umaThread = tempo.mediana;
+		}
+		double speedup = tempo.mediana > 0 ? (double)umaThread / (double)tempo.mediana : 0.0;
+		printf("%7d | %12lld | %6.2fx | %9.0f%% | %ld%s\n", estatisticas.threads, tempo.mediana, speedup,
+			100.0 * speedup / estatisticas.threads, comparacoes, comparacoes == comparacoesSequencial ? " (= sequencial)" : " (DIFERENTE)");
+		if (t == maximo) {
+			break;
+		}
+	}
+	free(trabalho);
+}
+
+/* ========== CONTAGEM (CHAVES DE DOMÍNIO PEQUENO) ========== */
+
+/* Distribuição estável: conta cada chave em [0, faixas), acumula as posições
+ * iniciais e espalha os componentes num buffer na ordem original. Nenhuma
+ * comparação entre elementos; os movimentos vão para trocasOrdenacao. */
+static void distribuirPorChave(Componente componentes[], int total, const int chaves[], int faixas) {
+	int *inicioFaixa = (int *)calloc((size_t)faixas + 1, sizeof(int));
+	Componente *destino = (Componente *)malloc((size_t)total * sizeof(Componente));
+	if (!inicioFaixa || !destino) {
+		free(inicioFaixa);
+		free(destino);
+		avisar("Falha ao alocar memoria.\n");
+		return;
+	}
+	for (int i = 0; i < total; i++) {
+		inicioFaixa[chaves[i] + 1]++;
+	}
+	for (int f = 0; f < faixas; f++) {
+		inicioFaixa[f + 1] += inicioFaixa[f];
+	}
+	for (int i = 0; i < total; i++) {
+		destino[inicioFaixa[chaves[i]]++] = componentes[i];
+	}
+	memcpy(componentes, destino, (size_t)total * sizeof(Componente));
+	trocasOrdenacao += total;
+	free(destino);
+	free(inicioFaixa);
+}
+
+/* Counting sort por prioridade (1-10, já limitada no cadastro): O(n). */
+void countingSortPrioridade(Componente componentes[], int total, long *comparacoes) {
+	*comparacoes = 0;
+	if (total < 2) {
+		return;
+	}
+	int *chaves = (int *)malloc((size_t)total * sizeof(int));
+	if (!chaves) {
+		avisar("Falha ao alocar memoria.\n");
+		return;
+	}
+	for (int i = 0; i < total; i++) {
+		int prioridade = componentes[i].prioridade;
+		chaves[i] = (prioridade < 1 ? 1 : prioridade > 10 ? 10 : prioridade) - 1;
+	}
+	distribuirPorChave(componentes, total, chaves, 10);
+	free(chaves);
+}
+
+/* Counting sort por tipo: o posto alfabético do id interno já é a chave 0..k-1. */
+void countingSortTipo(Componente componentes[], int total, long *comparacoes) {
+	*comparacoes = 0;
+	if (total < 2) {
+		return;
+	}
+	int *chaves = (int *)malloc((size_t)total * sizeof(int));
+	if (!chaves) {
+		avisar("Falha ao alocar memoria.\n");
+		return;
+	}
+	for (int i = 0; i < total; i++) {
+		chaves[i] = tabelaTipos.posto[componentes[i].tipo];
+	}
+	distribuirPorChave(componentes, total, chaves, tabelaTipos.total);
+	free(chaves);
+}
+
+static const ComparadorComponente comparadoresCriterio[TOTAL_CRITERIOS] = {
+	compararPorNome, compararPorTipo, compararPorPrioridade,
+	compararPorPrioridadeDescNome, compararPorTipoPrioridadeDesc
+};
+
+static const char *nomesCriterio[TOTAL_CRITERIOS] = {
+	"NOME", "TIPO", "PRIORIDADE", "PRIORIDADE DESC + NOME", "TIPO + PRIORIDADE DESC"
+};
+
+/* Monta (ou remonta) a visão do critério sem tocar em torre->itens: a
+ * permutação de índices passa pelo mesmo Merge Sort natural dos componentes,
+ * comparando os componentes apontados e movendo só ints. */
+int ordenarVisao(VetorComponentes *torre, Criterio criterio, long *comparacoes) {
+	*comparacoes = 0;
+	int *indices = (int *)realloc(torre->visoes[criterio], (size_t)(torre->total > 0 ? torre->total : 1) * sizeof(int));
+	if (!indices) {
+		avisar("Falha ao alocar memoria.\n");
+		return 0;
+	}
+	torre->visoes[criterio] = indices;
+	for (int i = 0; i < torre->total; i++) {
+		indices[i] = i;
+	}
+	ContextoComponentes contexto = {comparadoresCriterio[criterio], torre->itens};
+	Sequencia sequencia = {(unsigned char *)indices, sizeof(int), compararIndicesSequencia, &contexto};
+	long movimentosAntes = trocasOrdenacao; /* a visão não move componentes */
+	int ok = ordenarSequencia(&sequencia, torre->total, comparacoes);
+	trocasOrdenacao = movimentosAntes;
+	torre->visaoValida[criterio] = ok;
+	return ok;
+}
+
+/* Índice secundário sob demanda: só reordena se a visão estiver obsoleta. */
+int garantirVisao(VetorComponentes *torre, Criterio criterio, long *comparacoes) {
+	*comparacoes = 0;
+	if (torre->visaoValida[criterio]) {
+		return 1;
+	}
+	return ordenarVisao(torre, criterio, comparacoes);
+}
+
+/* Encaixa o componente recém-acrescentado (último índice) em cada visão
+ * válida: busca binária pela posição após os iguais e um memmove, mantendo
+ * os índices secundários vivos sem reordenar tudo. */
+void inserirNasVisoes(VetorComponentes *torre, int novo) {
+	for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+		if (!torre->visaoValida[c]) {
+			continue;
+		}
+		int *indices = (int *)realloc(torre->visoes[c], (size_t)(novo + 1) * sizeof(int));
+		if (!indices) {
+			torre->visaoValida[c] = 0;
+			continue;
+		}
+		torre->visoes[c] = indices;
+		int inicio = 0;
+		int fim = novo;
+		while (inicio < fim) {
+			int meio = inicio + (fim - inicio) / 2;
+			if (comparadoresCriterio[c](&torre->itens[indices[meio]], &torre->itens[novo]) <= 0) {
+				inicio = meio + 1;
+			} else {
+				fim = meio;
+			}
+		}
+		memmove(&indices[inicio + 1], &indices[inicio], (size_t)(novo - inicio) * sizeof(int));
+		indices[inicio] = novo;
+	}
+}
+
+/* Faixa "tipo == X e prioridade >= p" pela visão tipo+prioridade desc: duas
+ * buscas binárias delimitam um trecho contíguo. Devolve o total e, em
+ * *resultado, o início do trecho dentro da visão. */
+int consultarTipoPrioridade(VetorComponentes *torre, const char *tipo, int prioridadeMinima, const int **resultado, long *comparacoes) {
+	long comparacoesVisao = 0;
+	*resultado = NULL;
+	int idTipo = buscarTipo(tipo);
+	if (idTipo < 0 || !garantirVisao(torre, CRITERIO_TIPO_PRIORIDADE, &comparacoesVisao)) {
+		return 0;
+	}
+	*comparacoes = comparacoesVisao;
+	const int *indices = torre->visoes[CRITERIO_TIPO_PRIORIDADE];
+	int inicio = 0;
+	int fim = torre->total;
+	while (inicio < fim) {
+		int meio = inicio + (fim - inicio) / 2;
+		(*comparacoes)++;
+		if (compararTipos(torre->itens[indices[meio]].tipo, (IdTipo)idTipo) < 0) {
+			inicio = meio + 1;
+		} else {
+			fim = meio;
+		}
+	}
+	int primeiro = inicio;
+	fim = torre->total;
+	while (inicio < fim) {
+		int meio = inicio + (fim - inicio) / 2;
+		const Componente *c = &torre->itens[indices[meio]];
+		(*comparacoes)++;
+		if (c->tipo == idTipo && c->prioridade >= prioridadeMinima) {
+			inicio = meio + 1;
+		} else {
+			fim = meio;
+		}
+	}
+	*resultado = &indices[primeiro];
+	return inicio - primeiro;
+}
+
+/* Reordena fisicamente segundo a visão escolhida. As demais visões válidas
+ * são remapeadas pela permutação inversa em vez de reordenadas. */
+int aplicarVisao(VetorComponentes *torre, Criterio criterio) {
+	const int *indices = torre->visoes[criterio];
+	Componente *reordenados = (Componente *)malloc((size_t)torre->capacidade * sizeof(Componente));
+	int *novaPosicao = (int *)malloc((size_t)torre->total * sizeof(int));
+	if (!reordenados || !novaPosicao) {
+		free(reordenados);
+		free(novaPosicao);
+		avisar("Falha ao alocar memoria.\n");
+		return 0;
+	}
+	for (int i = 0; i < torre->total; i++) {
+		reordenados[i] = torre->itens[indices[i]];
+		novaPosicao[indices[i]] = i;
+	}
+	for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+		if (!torre->visaoValida[c]) {
+			continue;
+		}
+		for (int i = 0; i < torre->total; i++) {
+			torre->visoes[c][i] = novaPosicao[torre->visoes[c][i]];
+		}
+	}
+	free(novaPosicao);
+	free(torre->itens);
+	torre->itens = reordenados;
+	torre->eytzinger.sincronizado = 0;
+	return 1;
+}
+
+/* Qualquer alteração nos componentes torna as permutações obsoletas. */
+void invalidarVisoes(VetorComponentes *torre) {
+	for (int c = 0; c < TOTAL_CRITERIOS; c++) {
+		torre->visaoValida[c] = 0;
+	}
+	torre->eytzinger.sincronizado = 0;
+}
+
+/* Busca binária pela visão de nome; devolve a posição física do componente. */
+int buscaBinariaVisaoNome(const VetorComponentes *torre, const char *nomeBuscado, long *comparacoes) {
+	*comparacoes = 0;
+	const int *indices = torre->visoes[CRITERIO_NOME];
+	int inicio = 0;
+	int fim = torre->total - 1;
+	while (inicio <= fim) {
+		int meio = inicio + (fim - inicio) / 2;
+		(*comparacoes)++;
+		int cmp = strcmp(torre->itens[indices[meio]].nome, nomeBuscado);
+		if (cmp == 0) {
+			return indices[meio];
+		} else if (cmp < 0) {
+			inicio = meio + 1;
+		} else {
+			fim = meio - 1;
+		}
+	}
+	return -1;
+}
+
+/* Lista os componentes na ordem da visão, sem alterar o vetor. */
+void mostrarVisao(const VetorComponentes *torre, Criterio criterio) {
+	const int *indices = torre->visoes[criterio];
+	printf("\n=== VISAO POR %s (%d) ===\n", nomesCriterio[criterio], torre->total);
+	printf("%-4s %-6s %-25s %-18s %s\n", "#", "POS", "NOME", "TIPO", "PRIORIDADE");
+	printf("----------------------------------------------------------\n");
+	for (int i = 0; i < torre->total; i++) {
+		const Componente *c = &torre->itens[indices[i]];
+		printf("%-4d %-6d %-25s %-18s %d\n", i + 1, indices[i] + 1, c->nome, nomeTipo(c->tipo), c->prioridade);
+	}
+	printf("==========================================================\n");
+}
+
+/* Busca Binária: busca componente por NOME (requer ordenação prévia por nome) */
+int buscaBinariaPorNome(Componente componentes[], int total, const char *nomeBuscado, long *comparacoes) {
+	*comparacoes = 0;
+	int inicio = 0;
+	int fim = total - 1;
+	while (inicio <= fim) {
+		int meio = inicio + (fim - inicio) / 2;
+		(*comparacoes)++;
+		int cmp = strcmp(componentes[meio].nome, nomeBuscado);
+		if (cmp == 0) {
+			return meio;
+		} else if (cmp < 0) {
+			inicio = meio + 1;
+		} else {
+			fim = meio - 1;
+		}
+	}
+	return -1;
+}
+
+/* Exibe todos os componentes da torre formatados */
+void mostrarComponentes(const Componente componentes[], int total) {
+	printf("\n=== COMPONENTES DA TORRE (%d) ===\n", total);
+	if (total == 0) {
+		printf("(Nenhum componente cadastrado)\n");
+		return;
+	}
+	printf("%-4s %-25s %-18s %s\n", "#", "NOME", "TIPO", "PRIORIDADE");
+	printf("---------------------------------------------------\n");
+	for (int i = 0; i < total; i++) {
+		printf("%-4d %-25s %-18s %d\n", i + 1, componentes[i].nome, nomeTipo(componentes[i].tipo), componentes[i].prioridade);
+	}
+	printf("===================================================\n");
+}
+
+/* Mede o tempo de execução de um algoritmo de ordenação em ns (relógio monotônico).
+ * Com repetições, a entrada original é restaurada antes de cada rodada. */
+EstatisticasTempo medirTempoOrdenacao(void (*algoritmo)(Componente[], int, long*), Componente componentes[], int total, long *comparacoes) {
+	int repeticoes = repeticoesMedicao;
+	Componente *original = NULL;
+	if (repeticoes > 1) {
+		original = (Componente *)malloc((size_t)total * sizeof(Componente) + 1);
+		if (original) {
+			memcpy(original, componentes, (size_t)total * sizeof(Componente));
+		} else {
+			repeticoes = 1;
+		}
+	}
+	OrdenacaoMedida ordenacao = novaOrdenacao(componentes, original, total, comparacoes);
+	ordenacao.algoritmo = algoritmo;
+	EstatisticasTempo estatisticas = medirOrdenacao(&ordenacao, repeticoes);
+	free(original);
+	return estatisticas;
+}
+
+
+
+/* ========== ÍNDICE EYTZINGER (LAYOUT BFS) ========== */
+
+#if defined(__GNUC__)
+#define PREFETCH_LEITURA(endereco) __builtin_prefetch((endereco), 0, 1)
+#else
+#define PREFETCH_LEITURA(endereco) ((void)0)
+#endif
+
+/* Percorre a árvore implícita em ordem simétrica: o i-ésimo nome da origem
+ * ordenada vai para o nó k visitado na i-ésima vez. Devolve o próximo i. */
+static int preencherEytzinger(IndiceEytzinger *indice, const char *primeiroNome, size_t passo, const int *ordem, int i, int k) {
+	if (k > indice->total) {
+		return i;
+	}
+	i = preencherEytzinger(indice, primeiroNome, passo, ordem, i, 2 * k);
+	int origem = ordem ? ordem[i] : i;
+	memcpy(indice->nomes[k], primeiroNome + (size_t)origem * passo, TAM_NOME);
+	indice->posicoes[k] = origem;
+	return preencherEytzinger(indice, primeiroNome, passo, ordem, i + 1, 2 * k + 1);
+}
+
+/* Monta o índice a partir de 'total' registros de tamanho 'passo' cujo nome
+ * começa em 'primeiroNome'. Com 'ordem', a origem é lida na sequência dessa
+ * permutação (visão por nome); sem ela, a origem já deve estar ordenada. */
+int construirEytzinger(IndiceEytzinger *indice, const char *primeiroNome, size_t passo, const int *ordem, int total) {
+	indice->sincronizado = 0;
+	if (total > indice->capacidade) {
+		void *nomes = NULL;
+		int *posicoes = (int *)malloc((size_t)(total + 1) * sizeof(int));
+		/* Alinhado a 64: nomes[2k] e nomes[2k+1] caem na mesma linha. */
+		if (!posicoes || posix_memalign(&nomes, 64, (size_t)(total + 1) * TAM_NO_EYTZINGER) != 0) {
+			free(posicoes);
+			avisar("Falha ao alocar memoria.\n");
+			return 0;
+		}
+		free(indice->nomes);
+		free(indice->posicoes);
+		indice->nomes = (char (*)[TAM_NO_EYTZINGER])nomes;
+		indice->posicoes = posicoes;
+		indice->capacidade = total;
+	}
+	indice->total = total;
+	preencherEytzinger(indice, primeiroNome, passo, ordem, 0, 1);
+	indice->sincronizado = 1;
+	return 1;
+}
+
+/* Desce sempre até uma folha, sem sair ao achar o nome: o próximo nó é
+ * 2k + (nome[k] < buscado), calculado sem desvio condicional. Enquanto isso
+ * os 8 bisnetos (quatro linhas de cache) já são pedidos à memória; dois
+ * níveis à frente ainda deixavam a descida esperando. Perto das folhas os
+ * bisnetos passam do fim do vetor: o endereço é calculado como inteiro, já
+ * que formar esse ponteiro seria indefinido, e o prefetch não falha.
+ * No fim, os bits 1 finais de k são as descidas à direita após o último
+ * passo à esquerda; removê-los dá o menor nome >= buscado, conferido com
+ * uma comparação extra. */
+int buscarEytzinger(const IndiceEytzinger *indice, const char *nome, long *comparacoes) {
+	const char (*nomes)[TAM_NO_EYTZINGER] = (const char (*)[TAM_NO_EYTZINGER])indice->nomes;
+	unsigned int total = (unsigned int)indice->total;
+	unsigned int k = 1;
+	while (k <= total) {
+		uintptr_t bisnetos = (uintptr_t)nomes + 8 * (uintptr_t)k * TAM_NO_EYTZINGER;
+		PREFETCH_LEITURA((const void *)bisnetos);
+		PREFETCH_LEITURA((const void *)(bisnetos + 2 * TAM_NO_EYTZINGER));
+		PREFETCH_LEITURA((const void *)(bisnetos + 4 * TAM_NO_EYTZINGER));
+		PREFETCH_LEITURA((const void *)(bisnetos + 6 * TAM_NO_EYTZINGER));
+		(*comparacoes)++;
+		k = 2 * k + (strcmp(nomes[k], nome) < 0);
+	}
+#if defined(__GNUC__)
+	k >>= __builtin_ffs((int)~k);
+#else
+	while (k & 1) {
+		k >>= 1;
+	}
+	k >>= 1;
+#endif
+	if (k == 0) {
+		return -1;
+	}
+	(*comparacoes)++;
+	return strcmp(nomes[k], nome) == 0 ? indice->posicoes[k] : -1;
+}
+
+/* Refaz o índice do vetor só quando a versão mudou; o chamador garante que
+ * o vetor está ordenado por nome. */
+int sincronizarEytzingerVetor(VetorItens *mochila) {
+	IndiceEytzinger *indice = &mochila->eytzinger;
+	if (indice->sincronizado && indice->versao == mochila->versao) {
+		return 1;
+	}
+	if (!construirEytzinger(indice, mochila->itens ? mochila->itens[0].nome : "", sizeof(Item), NULL, mochila->tamanho)) {
+		return 0;
+	}
+	indice->versao = mochila->versao;
+	return 1;
+}
+
+/* Torre fora da ordem por nome é lida pela visão de nome (montada se preciso). */
+int sincronizarEytzingerTorre(VetorComponentes *torre, int ordenadoPorNome, long *comparacoes) {
+	*comparacoes = 0;
+	if (torre->eytzinger.sincronizado) {
+		return 1;
+	}
+	const int *ordem = NULL;
+	if (!ordenadoPorNome) {
+		if (!garantirVisao(torre, CRITERIO_NOME, comparacoes)) {
+			return 0;
+		}
+		ordem = torre->visoes[CRITERIO_NOME];
+	}
+	return construirEytzinger(&torre->eytzinger, torre->itens ? torre->itens[0].nome : "", sizeof(Componente), ordem, torre->total);
+}
+
+void liberarEytzinger(IndiceEytzinger *indice) {
+	free(indice->nomes);
+	free(indice->posicoes);
+	indice->nomes = NULL;
+	indice->posicoes = NULL;
+	indice->total = 0;
+	indice->capacidade = 0;
+	indice->sincronizado = 0;
+}
+
+/* ========== BUSCA POR PREFIXO E INTERVALO DE NOMES ========== */
+
+FaixaNomes faixaPrefixo(const char *prefixo) {
+	FaixaNomes faixa = {prefixo, prefixo, 1, strlen(prefixo)};
+	return faixa;
+}
+
+FaixaNomes faixaIntervalo(const char *de, const char *ate) {
+	FaixaNomes faixa = {de, ate, 0, 0};
+	return faixa;
+}
+
+/* Compara o nome com uma ponta da faixa: só os primeiros caracteres no modo prefixo. */
+static int compararPontaFaixa(const char *nome, const char *ponta, const FaixaNomes *faixa) {
+	return faixa->porPrefixo ? strncmp(nome, ponta, faixa->tamanhoPrefixo) : strcmp(nome, ponta);
+}
+
+/* Limite inferior (primeiro nome >= 'de') ou superior (primeiro nome > 'ate'). */
+static int limiteFaixaVetor(const Item mochila[], int tamanho, const FaixaNomes *faixa, int superior, long *comparacoes) {
+	int inicio = 0;
+	int fim = tamanho;
+	while (inicio < fim) {
+		int meio = inicio + (fim - inicio) / 2;
+		(*comparacoes)++;
+		int cmp = compararPontaFaixa(mochila[meio].nome, superior ? faixa->ate : faixa->de, faixa);
+		if (superior ? cmp <= 0 : cmp < 0) {
+			inicio = meio + 1;
+		} else {
+			fim = meio;
+		}
+	}
+	return inicio;
+}
+
+/* Faixa contígua no vetor ordenado por nome: duas buscas binárias, O(log n);
+ * percorrer os k resultados fica com quem chama. Devolve k e o início em *inicio. */
+int buscarFaixaVetor(const Item mochila[], int tamanho, FaixaNomes faixa, int *inicio, long *comparacoes) {
+	*inicio = limiteFaixaVetor(mochila, tamanho, &faixa, 0, comparacoes);
+	int fim = limiteFaixaVetor(mochila, tamanho, &faixa, 1, comparacoes);
+	return fim > *inicio ? fim - *inicio : 0;
+}
+
+/* Mesma faixa sobre a visão por nome da torre (montada se estiver obsoleta). */
+int buscarFaixaTorre(VetorComponentes *torre, FaixaNomes faixa, const int **indices, long *comparacoes) {
+	long comparacoesVisao = 0;
+	*indices = NULL;
+	if (!garantirVisao(torre, CRITERIO_NOME, &comparacoesVisao)) {
+		return 0;
+	}
+	*comparacoes += comparacoesVisao;
+	const int *visao = torre->visoes[CRITERIO_NOME];
+	int limites[2];
+	for (int superior = 0; superior < 2; superior++) {
+		int inicio = 0;
+		int fim = torre->total;
+		while (inicio < fim) {
+			int meio = inicio + (fim - inicio) / 2;
+			(*comparacoes)++;
+			int cmp = compararPontaFaixa(torre->itens[visao[meio]].nome, superior ? faixa.ate : faixa.de, &faixa);
+			if (superior ? cmp <= 0 : cmp < 0) {
+				inicio = meio + 1;
+			} else {
+				fim = meio;
+			}
+		}
+		limites[superior] = inicio;
+	}
+	*indices = &visao[limites[0]];
+	return limites[1] > limites[0] ? limites[1] - limites[0] : 0;
+}
+
+/* Lista não ordenada: testa todos os nós, O(n) sempre. Guarda até 'maximo'
+ * nós em 'encontrados' e devolve o total. */
+int buscarFaixaLista(const No *inicio, FaixaNomes faixa, const No *encontrados[], int maximo, long *comparacoes) {
+	int total = 0;
+	for (; inicio; inicio = inicio->proximo) {
+		(*comparacoes)++;
+		if (compararPontaFaixa(inicio->dados.nome, faixa.de, &faixa) < 0) {
+			continue;
+		}
+		(*comparacoes)++;
+		if (compararPontaFaixa(inicio->dados.nome, faixa.ate, &faixa) > 0) {
+			continue;
+		}
+		if (total < maximo) {
+			encontrados[total] = inicio;
+		}
+		total++;
+	}
+	return total;
+}
+
+/* Pergunta prefixo ou intervalo; os textos ficam em 'de'/'ate' (tamanho TAM_NOME). */
+int lerFaixaNomes(char de[], char ate[], FaixaNomes *faixa) {
+	int modo;
+	printf("1) Prefixo  2) Intervalo [de, ate]: ");
+	if (scanf("%d", &modo) != 1 || modo < 1 || modo > 2) {
+		printf("Opcao invalida.\n");
+		limparBufferEntrada();
+		return 0;
+	}
+	limparBufferEntrada();
+	if (modo == 1) {
+		printf("Prefixo: ");
+		lerLinha(de, TAM_NOME);
+		*faixa = faixaPrefixo(de);
+	} else {
+		printf("De: ");
+		lerLinha(de, TAM_NOME);
+		printf("Ate: ");
+		lerLinha(ate, TAM_NOME);
+		*faixa = faixaIntervalo(de, ate);
+	}
+	return 1;
+}
+
+/* ========== BUSCA EM LOTE ========== */
+
+/* Lê um nome por linha (linhas vazias são ignoradas). */
+int lerLoteNomes(const char *caminho, LoteNomes *lote) {
+	FILE *arquivo = fopen(caminho, "r");
+	if (!arquivo) {
+		avisar("Nao foi possivel abrir %s\n", caminho);
+		return 0;
+	}
+	char linha[256];
+	int ok = 1;
+	lote->total = 0;
+	while (fgets(linha, sizeof(linha), arquivo)) {
+		linha[strcspn(linha, "\r\n")] = '\0';
+		if (linha[0] == '\0') {
+			continue;
+		}
+		if (!crescerBuffer((void **)&lote->nomes, &lote->capacidade, lote->total + 1, sizeof(*lote->nomes))) {
+			ok = 0;
+			break;
+		}
+		size_t tamanho = strlen(linha) < TAM_NOME - 1 ? strlen(linha) : TAM_NOME - 1;
+		memcpy(lote->nomes[lote->total], linha, tamanho);
+		lote->nomes[lote->total][tamanho] = '\0';
+		lote->total++;
+	}
+	fclose(arquivo);
+	return ok;
+}
+
+void liberarLoteNomes(LoteNomes *lote) {
+	free(lote->nomes);
+	lote->nomes = NULL;
+	lote->total = 0;
+	lote->capacidade = 0;
+}
+
+static int compararConsultas(const void *a, const void *b) {
+	return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/* Ordena ponteiros para os nomes do lote; a posição de origem sai da diferença
+ * entre o ponteiro e o início do lote. */
+static const char **ordenarConsultas(const LoteNomes *lote) {
+	const char **ordem = (const char **)malloc((size_t)lote->total * sizeof(char *) + 1);
+	if (!ordem) {
+		avisar("Falha ao alocar memoria.\n");
+		return NULL;
+	}
+	for (int q = 0; q < lote->total; q++) {
+		ordem[q] = lote->nomes[q];
+	}
+	qsort(ordem, (size_t)lote->total, sizeof(char *), compararConsultas);
+	return ordem;
+}
+
+/* Uma passada de intercalação entre as consultas ordenadas e um inventário
+ * ordenado por nome. O nome i fica em base + (visao ? visao[i] : i) * passo
+ * (nome é o primeiro campo de Item e de Componente). O avanço no inventário
+ * é por galope (1, 2, 4, ...) seguido de busca binária, então poucas
+ * consultas custam O(m log(n/m)) e não O(n). */
+static int intercalarLote(const char *base, size_t passo, const int *visao, int tamanho, const LoteNomes *lote, const char **ordem, int posicoes[], long *comparacoes) {
+#define NOME_LOTE(i) (base + (size_t)(visao ? visao[i] : (i)) * passo)
+	int encontrados = 0;
+	int i = 0;
+	for (int q = 0; q < lote->total; q++) {
+		const char *nome = ordem[q];
+		int origem = (int)((nome - lote->nomes[0]) / TAM_NOME);
+		int salto = 1;
+		int antes = i - 1; /* maior posição sabidamente menor que 'nome' */
+		while (i < tamanho) {
+			(*comparacoes)++;
+			if (strcmp(NOME_LOTE(i), nome) >= 0) {
+				break;
+			}
+			antes = i;
+			i += salto;
+			salto *= 2;
+		}
+		int fim = i < tamanho ? i : tamanho;
+		i = antes + 1;
+		while (i < fim) {
+			int meio = i + (fim - i) / 2;
+			(*comparacoes)++;
+			if (strcmp(NOME_LOTE(meio), nome) < 0) {
+				i = meio + 1;
+			} else {
+				fim = meio;
+			}
+		}
+		posicoes[origem] = -1;
+		if (i < tamanho) {
+			(*comparacoes)++;
+			if (strcmp(NOME_LOTE(i), nome) == 0) {
+				posicoes[origem] = visao ? visao[i] : i;
+				encontrados++;
+			}
+		}
+	}
+	return encontrados;
+#undef NOME_LOTE
+}
+
+/* Fatia de consultas resolvida por uma thread com busca sequencial. */
+typedef struct {
+	const Item *itens; /* vetor, ou NULL para a lista */
+	int tamanho;
+	const No *inicio;
+	const LoteNomes *lote;
+	int de;
+	int ate;
+	int *posicoes;
+	const No **nos;
+	ContadoresThread *contadores;
+} FatiaLote;
+
+static void *resolverFatiaLote(void *argumento) {
+	FatiaLote *fatia = (FatiaLote *)argumento;
+	for (int q = fatia->de; q < fatia->ate; q++) {
+		const char *nome = fatia->lote->nomes[q];
+		if (fatia->itens) {
+			fatia->posicoes[q] = buscarSequencialVetor(fatia->itens, fatia->tamanho, nome, &fatia->contadores->comparacoes);
+		} else {
+			fatia->nos[q] = buscarSequencialLista(fatia->inicio, nome, &fatia->contadores->comparacoes);
+		}
+	}
+	return NULL;
+}
+
+/* Reparte as consultas em fatias contíguas, uma por thread (a chamadora
+ * fica com a primeira); devolve quantas threads rodaram. */
+static int repartirLote(const FatiaLote *modelo, int threads, long *comparacoes) {
+	int total = modelo->lote->total;
+	if (threads > MAX_THREADS_ORDENACAO) {
+		threads = MAX_THREADS_ORDENACAO;
+	}
+	if (threads > total) {
+		threads = total > 0 ? total : 1;
+	}
+	if (threads < 1) {
+		threads = 1;
+	}
+	ContadoresThread contadores[MAX_THREADS_ORDENACAO];
+	FatiaLote fatias[MAX_THREADS_ORDENACAO];
+	pthread_t ids[MAX_THREADS_ORDENACAO];
+	int criada[MAX_THREADS_ORDENACAO] = {0};
+	memset(contadores, 0, sizeof(contadores));
+	for (int t = 0; t < threads; t++) {
+		fatias[t] = *modelo;
+		fatias[t].de = (int)((long)total * t / threads);
+		fatias[t].ate = (int)((long)total * (t + 1) / threads);
+		fatias[t].contadores = &contadores[t];
+	}
+	for (int t = 1; t < threads; t++) {
+		criada[t] = pthread_create(&ids[t], NULL, resolverFatiaLote, &fatias[t]) == 0;
+	}
+	resolverFatiaLote(&fatias[0]);
+	for (int t = 1; t < threads; t++) {
+		if (criada[t]) {
+			pthread_join(ids[t], NULL);
+		} else {
+			resolverFatiaLote(&fatias[t]); /* sem thread: resolve aqui mesmo */
+		}
+	}
+	for (int t = 0; t < threads; t++) {
+		*comparacoes += contadores[t].comparacoes;
+	}
+	return threads;
+}
+
+/* Resolve o lote no vetor: com o vetor ordenado, ordena as consultas e faz uma
+ * passada de intercalação; senão, busca sequencial repartida entre 'threads'.
+ * posicoes[q] recebe a posição de lote->nomes[q] (-1 se ausente). */
+int buscarLoteVetor(const VetorItens *mochila, int ordenado, const LoteNomes *lote, int posicoes[], int threads, long *comparacoes) {
+	if (ordenado) {
+		const char **ordem = ordenarConsultas(lote);
+		if (!ordem) {
+			return 0;
+		}
+		int encontrados = intercalarLote((const char *)mochila->itens, sizeof(Item), NULL, mochila->tamanho, lote, ordem, posicoes, comparacoes);
+		free(ordem);
+		return encontrados;
+	}
+	FatiaLote modelo = {0};
+	modelo.itens = mochila->itens;
+	modelo.tamanho = mochila->tamanho;
+	modelo.lote = lote;
+	modelo.posicoes = posicoes;
+	if (!modelo.itens) {
+		for (int q = 0; q < lote->total; q++) {
+			posicoes[q] = -1;
+		}
+		return 0;
+	}
+	repartirLote(&modelo, threads, comparacoes);
+	int encontrados = 0;
+	for (int q = 0; q < lote->total; q++) {
+		encontrados += posicoes[q] >= 0;
+	}
+	return encontrados;
+}
+
+/* Lista: sem ordem para intercalar, as consultas são repartidas entre threads. */
+int buscarLoteLista(const ListaItens *lista, const LoteNomes *lote, const No *encontradosPorNome[], int threads, long *comparacoes) {
+	FatiaLote modelo = {0};
+	modelo.inicio = lista->inicio;
+	modelo.lote = lote;
+	modelo.nos = encontradosPorNome;
+	repartirLote(&modelo, threads, comparacoes);
+	int encontrados = 0;
+	for (int q = 0; q < lote->total; q++) {
+		encontrados += encontradosPorNome[q] != NULL;
+	}
+	return encontrados;
+}
+
+/* Torre: intercalação sobre a visão por nome (posições são índices em torre->itens). */
+int buscarLoteTorre(VetorComponentes *torre, const LoteNomes *lote, int posicoes[], long *comparacoes) {
+	long comparacoesVisao = 0;
+	if (!garantirVisao(torre, CRITERIO_NOME, &comparacoesVisao)) {
+		return 0;
+	}
+	*comparacoes += comparacoesVisao;
+	const char **ordem = ordenarConsultas(lote);
+	if (!ordem) {
+		return 0;
+	}
+	int encontrados = intercalarLote((const char *)torre->itens, sizeof(Componente), torre->visoes[CRITERIO_NOME], torre->total, lote, ordem, posicoes, comparacoes);
+	free(ordem);
+	return encontrados;
+}
+
+/* Contexto de menuLote para medirRepetido: resolve o lote no destino escolhido. */
+typedef struct {
+	DestinoCsv destino;
+	const VetorItens *mochila;
+	int vetorOrdenado;
+	const ListaItens *lista;
+	VetorComponentes *torre;
+	const LoteNomes *lote;
+	int *posicoes;
+	const No **nos;
+	int threads;
+	long *comparacoes;
+	int *encontrados;
+} LoteMedido;
+
+static void zerarLoteMedido(void *contexto) {
+	*((LoteMedido *)contexto)->comparacoes = 0;
+}
+
+static void executarLoteMedido(void *contexto) {
+	LoteMedido *medido = (LoteMedido *)contexto;
+	if (medido->destino == CSV_VETOR) {
+		*medido->encontrados = buscarLoteVetor(medido->mochila, medido->vetorOrdenado, medido->lote, medido->posicoes, medido->threads, medido->comparacoes);
+	} else if (medido->destino == CSV_LISTA) {
+		*medido->encontrados = buscarLoteLista(medido->lista, medido->lote, medido->nos, medido->threads, medido->comparacoes);
+	} else {
+		*medido->encontrados = buscarLoteTorre(medido->torre, medido->lote, medido->posicoes, medido->comparacoes);
+	}
+}
+
+/* Lê o arquivo, resolve o lote na estrutura escolhida e mostra as primeiras
+ * posições, o total de comparações e a vazão (buscas/s). */
+void menuLote(DestinoCsv destino, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, VetorComponentes *torre) {
+	char caminho[256];
+	printf("Arquivo com um nome por linha: ");
+	lerLinha(caminho, sizeof(caminho));
+	LoteNomes lote = {0};
+	if (!lerLoteNomes(caminho, &lote) || lote.total == 0) {
+		printf("Nenhum nome lido.\n");
+		liberarLoteNomes(&lote);
+		return;
+	}
+	int *posicoes = (int *)malloc((size_t)lote.total * sizeof(int));
+	const No **nos = (const No **)malloc((size_t)lote.total * sizeof(No *));
+	if (!posicoes || !nos) {
+		avisar("Falha ao alocar memoria.\n");
+		free(posicoes);
+		free(nos);
+		liberarLoteNomes(&lote);
+		return;
+	}
+	int threads = threadsDisponiveis();
+	long comparacoes = 0;
+	int encontrados = 0;
+	if (destino == CSV_VETOR) {
+		printf(vetorOrdenado ? "(vetor ordenado: uma passada de intercalacao)\n" : "(vetor fora de ordem: sequencial em %d thread(s))\n", threads);
+	} else if (destino == CSV_LISTA) {
+		printf("(lista: sequencial em %d thread(s))\n", threads);
+	} else {
+		printf("(torre: uma passada de intercalacao sobre a visao por nome)\n");
+	}
+	LoteMedido medido = {destino, mochila, vetorOrdenado, lista, torre, &lote, posicoes, nos, threads, &comparacoes, &encontrados};
+	EstatisticasTempo tempo = medirRepetido(repeticoesMedicao, zerarLoteMedido, executarLoteMedido, &medido);
+	for (int q = 0; q < lote.total && q < MAX_FAIXA_EXIBIDA; q++) {
+		if (destino == CSV_LISTA ? nos[q] == NULL : posicoes[q] < 0) {
+			printf("  %s: nao encontrado\n", lote.nomes[q]);
+		} else if (destino == CSV_LISTA) {
+			printf("  %s: encontrado (qtd %d)\n", lote.nomes[q], nos[q]->dados.quantidade);
+		} else {
+			printf("  %s: posicao %d\n", lote.nomes[q], posicoes[q] + 1);
+		}
+	}
+	if (lote.total > MAX_FAIXA_EXIBIDA) {
+		printf("  ... e mais %d nomes\n", lote.total - MAX_FAIXA_EXIBIDA);
+	}
+	printf("Encontrados: %d de %d | Comparacoes: %ld | ", encontrados, lote.total, comparacoes);
+	imprimirTempo(&tempo);
+	if (tempo.mediana > 0) {
+		printf("Vazao: %.0f buscas/s\n", lote.total * 1e9 / (double)tempo.mediana);
+	}
+	free(posicoes);
+	free(nos);
+	liberarLoteNomes(&lote);
+}
+
+/* ========== BENCHMARK (--bench) ========== */
+
+/* xorshift64*: gerador próprio para que a mesma semente gere os mesmos inventários em qualquer libc. */
+static unsigned long long estadoAleatorio = 0x9E3779B97F4A7C15ULL;
+
+static void semearAleatorio(unsigned long long semente) {
+	estadoAleatorio = semente ? semente : 0x9E3779B97F4A7C15ULL;
+}
+
+/* Variante com estado próprio, para threads que não podem dividir o global. */
+static unsigned long long proximoAleatorioDe(unsigned long long *estado) {
+	*estado ^= *estado >> 12;
+	*estado ^= *estado << 25;
+	*estado ^= *estado >> 27;
+	return *estado * 2685821657736338717ULL;
+}
+
+static unsigned long long proximoAleatorio(void) {
+	return proximoAleatorioDe(&estadoAleatorio);
+}
+
+static const char *tiposSinteticos[] = {"controle", "suporte", "propulsao"};
+
+/* Embaralha 0..n-1 (Fisher-Yates) para definir a ordem "aleatoria". */
+static void embaralharIndices(int indices[], int n) {
+	for (int i = 0; i < n; i++) {
+		indices[i] = i;
+	}
+	for (int i = n - 1; i > 0; i--) {
+		int j = (int)(proximoAleatorio() % (unsigned long long)(i + 1));
+		int tmp = indices[i];
+		indices[i] = indices[j];
+		indices[j] = tmp;
+	}
+}
+
+/* Nome sintético com zeros à esquerda: a ordem numérica coincide com a de strcmp. */
+static void nomeSintetico(char destino[TAM_NOME], int id) {
+	snprintf(destino, TAM_NOME, "Item%08d", id);
+}
+
+/* Gera n componentes com nomes únicos, tipo e prioridade aleatórios, em ordem aleatória. */
+static void gerarComponentes(Componente destino[], int n) {
+	int *ordem = (int *)malloc((size_t)n * sizeof(int));
+	if (!ordem) {
+		return;
+	}
+	embaralharIndices(ordem, n);
+	for (int i = 0; i < n; i++) {
+		nomeSintetico(destino[i].nome, ordem[i]);
+		destino[i].tipo = (IdTipo)internarTipo(tiposSinteticos[proximoAleatorio() % 3]);
+		destino[i].prioridade = 1 + (int)(proximoAleatorio() % 10);
+	}
+	free(ordem);
+}
+
+/* Coloca a entrada no estado pedido para o critério: ordenada, reversa ou aleatória (intocada). */
+static void prepararEntrada(Componente componentes[], int n, ComparadorComponente comparar, const char *entrada) {
+	if (strcmp(entrada, "aleatoria") == 0) {
+		return;
+	}
+	long ignorado = 0;
+	mergeSortComponentes(componentes, n, comparar, &ignorado);
+	if (strcmp(entrada, "reversa") == 0) {
+		for (int i = 0, j = n - 1; i < j; i++, j--) {
+			Componente tmp = componentes[i];
+			componentes[i] = componentes[j];
+			componentes[j] = tmp;
+		}
+	}
+}
+
+typedef struct {
+	FILE *saida;
+	int json;
+	int linhas;
+} RelatorioBench;
+
+/* Uma linha por medição: tempo total e, por operação, tempo, comparações e
+ * trocas ('comparacoes' e 'trocas' chegam somadas sobre as 'operacoes'). */
+static void registrarBench(RelatorioBench *relatorio, const char *algoritmo, const char *entrada, int n, long operacoes, long long tempoNs, long comparacoes, long trocas) {
+	double nsPorOperacao = operacoes > 0 ? (double)tempoNs / operacoes : 0.0;
+	double comparacoesPorOperacao = operacoes > 0 ? (double)comparacoes / operacoes : 0.0;
+	double trocasPorOperacao = operacoes > 0 ? (double)trocas / operacoes : 0.0;
+	if (relatorio->json) {
+		fprintf(relatorio->saida, "%s\n  {\"algoritmo\": \"%s\", \"entrada\": \"%s\", \"n\": %d, \"operacoes\": %ld, \"tempo_ns\": %lld, \"ns_por_operacao\": %.1f, \"comparacoes_por_operacao\": %.1f, \"trocas_por_operacao\": %.1f}",
+			relatorio->linhas > 0 ? "," : "", algoritmo, entrada, n, operacoes, tempoNs, nsPorOperacao, comparacoesPorOperacao, trocasPorOperacao);
+	} else {
+		fprintf(relatorio->saida, "%s,%s,%d,%ld,%lld,%.1f,%.1f,%.1f\n", algoritmo, entrada, n, operacoes, tempoNs, nsPorOperacao, comparacoesPorOperacao, trocasPorOperacao);
+	}
+	relatorio->linhas++;
+	fprintf(stderr, "  %-26s %-9s n=%-8d %14.1f ns/op  comparacoes/op=%.1f trocas/op=%.1f\n", algoritmo, entrada, n, nsPorOperacao, comparacoesPorOperacao, trocasPorOperacao);
+}
+
+#define CONSULTAS_LOGARITMICAS 200000
+
+/* Mede as buscas com 'consultas' nomes (metade presentes, metade ausentes).
+ * Roda uma vez por tamanho: as sequenciais varrem a base na ordem gerada e as
+ * logarítmicas exigem a cópia ordenada, então a entrada pedida não muda nada
+ * e as linhas saem sem rótulo de entrada. */
+static void benchBuscas(RelatorioBench *relatorio, const Componente base[], int n) {
+	const char *entrada = "";
+	int consultas = n > 0 ? 20000000 / n : 1;
+	if (consultas < 16) consultas = 16;
+	if (consultas > 10000) consultas = 10000;
+
+	Item *itens = (Item *)malloc((size_t)n * sizeof(Item));
+	Item *ordenados = (Item *)malloc((size_t)n * sizeof(Item));
+	No *nos = (No *)malloc((size_t)n * sizeof(No));
+	char (*nomes)[TAM_NOME] = malloc((size_t)consultas * sizeof(*nomes));
+	char (*nomesLog)[TAM_NOME] = malloc((size_t)CONSULTAS_LOGARITMICAS * sizeof(*nomesLog));
+	if (!itens || !ordenados || !nos || !nomes || !nomesLog) {
+		fprintf(stderr, "Memoria insuficiente para n=%d\n", n);
+		free(itens);
+		free(ordenados);
+		free(nos);
+		free(nomes);
+		free(nomesLog);
+		return;
+	}
+	for (int i = 0; i < n; i++) {
+		strcpy(itens[i].nome, base[i].nome);
+		itens[i].tipo = base[i].tipo;
+		itens[i].quantidade = base[i].prioridade;
+		nos[i].dados = itens[i];
+		nos[i].proximo = i + 1 < n ? &nos[i + 1] : NULL;
+	}
+	/* A busca binária exige o vetor ordenado por nome: nomes sintéticos são Item%08d de 0..n-1. */
+	for (int i = 0; i < n; i++) {
+		ordenados[i] = itens[i];
+		nomeSintetico(ordenados[i].nome, i);
+	}
+	for (int q = 0; q < consultas; q++) {
+		int id = (int)(proximoAleatorio() % (unsigned long long)n);
+		if (q % 2 == 0) {
+			nomeSintetico(nomes[q], id);
+		} else {
+			snprintf(nomes[q], TAM_NOME, "Faltando%08d", id);
+		}
+	}
+	/* Buscas logarítmicas usam bem mais consultas; os ausentes ficam entre
+	 * dois nomes existentes para não descerem sempre pelo mesmo caminho. */
+	for (int q = 0; q < CONSULTAS_LOGARITMICAS; q++) {
+		int id = (int)(proximoAleatorio() % (unsigned long long)n);
+		snprintf(nomesLog[q], TAM_NOME, q % 2 == 0 ? "Item%08d" : "Item%08d~", id);
+	}
+
+	long comparacoes = 0;
+	long long inicio = agoraNs();
+	for (int q = 0; q < consultas; q++) {
+		buscarSequencialVetor(itens, n, nomes[q], &comparacoes);
+	}
+	registrarBench(relatorio, "buscarSequencialVetor", entrada, n, consultas, agoraNs() - inicio, comparacoes, 0);
+
+	comparacoes = 0;
+	inicio = agoraNs();
+	for (int q = 0; q < CONSULTAS_LOGARITMICAS; q++) {
+		buscarBinariaVetor(ordenados, n, nomesLog[q], &comparacoes);
+	}
+	registrarBench(relatorio, "buscarBinariaVetor", entrada, n, CONSULTAS_LOGARITMICAS, agoraNs() - inicio, comparacoes, 0);
+
+	IndiceEytzinger eytzinger = {0};
+	inicio = agoraNs();
+	if (construirEytzinger(&eytzinger, ordenados[0].nome, sizeof(Item), NULL, n)) {
+		registrarBench(relatorio, "construirEytzinger", entrada, n, 1, agoraNs() - inicio, 0, 0);
+		comparacoes = 0;
+		inicio = agoraNs();
+		for (int q = 0; q < CONSULTAS_LOGARITMICAS; q++) {
+			buscarEytzinger(&eytzinger, nomesLog[q], &comparacoes);
+		}
+		registrarBench(relatorio, "buscarEytzinger", entrada, n, CONSULTAS_LOGARITMICAS, agoraNs() - inicio, comparacoes, 0);
+	}
+	liberarEytzinger(&eytzinger);
+
+	comparacoes = 0;
+	inicio = agoraNs();
+	for (int q = 0; q < consultas; q++) {
+		buscarSequencialLista(nos, nomes[q], &comparacoes);
+	}
+	registrarBench(relatorio, "buscarSequencialLista", entrada, n, consultas, agoraNs() - inicio, comparacoes, 0);
+
+	free(itens);
+	free(ordenados);
+	free(nos);
+	free(nomes);
+	free(nomesLog);
+}
+
+/* Mede uma ordenação da torre na entrada pedida; tamanhos pequenos repetem e usam a mediana. */
+static void benchOrdenacaoTorre(RelatorioBench *relatorio, const char *algoritmo, void (*ordenar)(Componente[], int, long *), ComparadorComponente chave, const Componente base[], Componente trabalho[], Componente entradaPreparada[], int n, const char *entrada) {
+	memcpy(entradaPreparada, base, (size_t)n * sizeof(Componente));
+	prepararEntrada(entradaPreparada, n, chave, entrada);
+	int repeticoes = n <= 1000 ? 21 : 1;
+	long comparacoes = 0;
+	OrdenacaoMedida ordenacao = novaOrdenacao(trabalho, entradaPreparada, n, &comparacoes);
+	ordenacao.algoritmo = ordenar;
+	EstatisticasTempo tempo = medirOrdenacao(&ordenacao, repeticoes);
+	registrarBench(relatorio, algoritmo, entrada, n, 1, tempo.mediana, comparacoes, trocasOrdenacao);
+}
+
+/* As ordenações do vetor operam sobre a mochila (reindexam o hash no fim, incluído no tempo). */
+static void benchOrdenarVetor(RelatorioBench *relatorio, const char *algoritmo, OrdenacaoVetor ordenar, const Componente base[], Componente entradaPreparada[], int n, const char *entrada) {
+	memcpy(entradaPreparada, base, (size_t)n * sizeof(Componente));
+	prepararEntrada(entradaPreparada, n, compararPorNome, entrada);
+	VetorItens mochila = {0};
+	if (!reservarVetor(&mochila, n)) {
+		return;
+	}
+	for (int i = 0; i < n; i++) {
+		strcpy(mochila.itens[i].nome, entradaPreparada[i].nome);
+		mochila.itens[i].tipo = entradaPreparada[i].tipo;
+		mochila.itens[i].quantidade = entradaPreparada[i].prioridade;
+	}
+	mochila.tamanho = n;
+	long comparacoes = 0;
+	trocasOrdenacao = 0;
+	long long inicio = agoraNs();
+	ordenar(&mochila, &comparacoes);
+	registrarBench(relatorio, algoritmo, entrada, n, 1, agoraNs() - inicio, comparacoes, trocasOrdenacao);
+	liberarVetor(&mochila);
+}
+
+/* Suíte completa: inventários sintéticos de 10^2 até 'tamanhoMaximo' itens
+ * (semente fixa), entradas ordenada/reversa/aleatória, saída CSV ou JSON.
+ * Algoritmos quadráticos rodam só até 'limiteQuadratico' elementos. */
+int executarBenchmark(const char *caminhoSaida, int tamanhoMaximo, int limiteQuadratico) {
+	static const char *entradas[] = {"ordenada", "reversa", "aleatoria"};
+	RelatorioBench relatorio = {stdout, 0, 0};
+	if (caminhoSaida && strcmp(caminhoSaida, "-") != 0) {
+		relatorio.saida = fopen(caminhoSaida, "w");
+		if (!relatorio.saida) {
+			fprintf(stderr, "Nao foi possivel criar %s\n", caminhoSaida);
+			return 1;
+		}
+		size_t len = strlen(caminhoSaida);
+		relatorio.json = len >= 5 && strcmp(caminhoSaida + len - 5, ".json") == 0;
+	}
+	if (relatorio.json) {
+		fprintf(relatorio.saida, "[");
+	} else {
+		fprintf(relatorio.saida, "algoritmo,entrada,n,operacoes,tempo_ns,ns_por_operacao,comparacoes_por_operacao,trocas_por_operacao\n");
+	}
+
+	modoSilencioso = 1;
+	fprintf(stderr, "Merge sort paralelo com %d thread(s)\n", threadsDisponiveis());
+	for (int n = 100; n <= tamanhoMaximo; n *= 10) {
+		Componente *base = (Componente *)malloc((size_t)n * sizeof(Componente));
+		Componente *trabalho = (Componente *)malloc((size_t)n * sizeof(Componente));
+		Componente *preparada = (Componente *)malloc((size_t)n * sizeof(Componente));
+		if (!base || !trabalho || !preparada) {
+			fprintf(stderr, "Memoria insuficiente para n=%d\n", n);
+			free(base);
+			free(trabalho);
+			free(preparada);
+			break;
+		}
+		semearAleatorio(20240601ULL + (unsigned long long)n);
+		gerarComponentes(base, n);
+		fprintf(stderr, "n = %d\n", n);
+		benchBuscas(&relatorio, base, n);
+		for (int e = 0; e < 3; e++) {
+			benchOrdenarVetor(&relatorio, "ordenarVetorParalelo", ordenarVetorParaleloPadrao, base, preparada, n, entradas[e]);
+			if (n <= limiteQuadratico) {
+				benchOrdenarVetor(&relatorio, "ordenarVetor", ordenarVetor, base, preparada, n, entradas[e]);
+				benchOrdenacaoTorre(&relatorio, "bubbleSortNome", bubbleSortNome, compararPorNome, base, trabalho, preparada, n, entradas[e]);
+				benchOrdenacaoTorre(&relatorio, "insertionSortTipo", insertionSortTipo, compararPorTipo, base, trabalho, preparada, n, entradas[e]);
+				benchOrdenacaoTorre(&relatorio, "selectionSortPrioridade", selectionSortPrioridade, compararPorPrioridade, base, trabalho, preparada, n, entradas[e]);
+			}
+			benchOrdenacaoTorre(&relatorio, "mergeSortNome", mergeSortNome, compararPorNome, base, trabalho, preparada, n, entradas[e]);
+			benchOrdenacaoTorre(&relatorio, "mergeSortTipo", mergeSortTipo, compararPorTipo, base, trabalho, preparada, n, entradas[e]);
+			benchOrdenacaoTorre(&relatorio, "mergeSortPrioridade", mergeSortPrioridade, compararPorPrioridade, base, trabalho, preparada, n, entradas[e]);
+			benchOrdenacaoTorre(&relatorio, "countingSortPrioridade", countingSortPrioridade, compararPorPrioridade, base, trabalho, preparada, n, entradas[e]);
+			benchOrdenacaoTorre(&relatorio, "countingSortTipo", countingSortTipo, compararPorTipo, base, trabalho, preparada, n, entradas[e]);
+			benchOrdenacaoTorre(&relatorio, "mergeSortParaleloNome", mergeSortParaleloNome, compararPorNome, base, trabalho, preparada, n, entradas[e]);
+			benchOrdenacaoTorre(&relatorio, "mergeSortParaleloTipo", mergeSortParaleloTipo, compararPorTipo, base, trabalho, preparada, n, entradas[e]);
+		}
+		free(base);
+		free(trabalho);
+		free(preparada);
+		if (n > tamanhoMaximo / 10) {
+			break;
+		}
+	}
+	modoSilencioso = 0;
+
+	if (relatorio.json) {
+		fprintf(relatorio.saida, "\n]\n");
+	}
+	if (relatorio.saida != stdout) {
+		fclose(relatorio.saida);
+		fprintf(stderr, "%d medicoes gravadas em %s\n", relatorio.linhas, caminhoSaida);
+	}
+	liberarTabelaTipos();
+	return 0;
+}
+
+/* ========== INVENTÁRIO CONCORRENTE (RWLOCK) ========== */
+
+/* O vetor fica no modo "manter ordenado" para a binária estar sempre
+ * disponível. Buscas pegam o lock de leitura e copiam o item encontrado, de
+ * modo que o resultado vem de um estado consistente; inserções e remoções
+ * pegam o lock de escrita. O rwlock padrão da glibc prefere leitores, e com
+ * leitores contínuos o escritor nunca entraria: por isso o tipo
+ * PREFER_WRITER_NONRECURSIVE, em que leitores novos esperam o escritor na
+ * fila (outras libcs, como a do macOS, já preferem o escritor). */
+int iniciarInventarioConcorrente(InventarioConcorrente *inventario) {
+	memset(inventario, 0, sizeof(*inventario));
+	pthread_rwlockattr_t atributos;
+	if (pthread_rwlockattr_init(&atributos) != 0) {
+		avisar("Falha ao criar o rwlock.\n");
+		return 0;
+	}
+#ifdef __GLIBC__
+	pthread_rwlockattr_setkind_np(&atributos, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+	int erro = pthread_rwlock_init(&inventario->trava, &atributos);
+	pthread_rwlockattr_destroy(&atributos);
+	if (erro != 0) {
+		avisar("Falha ao criar o rwlock.\n");
+		return 0;
+	}
+	inventario->ordenado = 1;
+	definirManterOrdenado(&inventario->vetor, 1, &inventario->ordenado);
+	return 1;
+}
+
+int inserirConcorrente(InventarioConcorrente *inventario, const char *nome, const char *tipo, int quantidade) {
+	pthread_rwlock_wrlock(&inventario->trava);
+	int ok = inserirItemVetor(&inventario->vetor, nome, tipo, quantidade, &inventario->ordenado);
+	pthread_rwlock_unlock(&inventario->trava);
+	return ok;
+}
+
+int removerConcorrente(InventarioConcorrente *inventario, const char *nome) {
+	pthread_rwlock_wrlock(&inventario->trava);
+	int ok = removerItemVetor(&inventario->vetor, nome, &inventario->ordenado);
+	pthread_rwlock_unlock(&inventario->trava);
+	return ok;
+}
+
+/* Busca binária (ou sequencial) sob o lock de leitura; 'copia' recebe o item. */
+int buscarConcorrente(InventarioConcorrente *inventario, const char *nome, int binaria, Item *copia, long *comparacoes) {
+	pthread_rwlock_rdlock(&inventario->trava);
+	const VetorItens *vetor = &inventario->vetor;
+	int pos = binaria && inventario->ordenado
+		? buscarBinariaVetor(vetor->itens, vetor->tamanho, nome, comparacoes)
+		: buscarSequencialVetor(vetor->itens, vetor->tamanho, nome, comparacoes);
+	if (pos >= 0 && copia) {
+		*copia = vetor->itens[pos];
+	}
+	pthread_rwlock_unlock(&inventario->trava);
+	return pos;
+}
+
+void liberarInventarioConcorrente(InventarioConcorrente *inventario) {
+	liberarVetor(&inventario->vetor);
+	pthread_rwlock_destroy(&inventario->trava);
+}
+
+/* Contadores de um leitor do teste de estresse, um por linha de cache. */
+typedef struct {
+	_Alignas(TAM_LINHA_CACHE) long buscas;
+	long encontrados;
+	long comparacoes;
+	long inconsistencias; /* item copiado com nome diferente do buscado */
+} ContadoresLeitor;
+
+typedef struct {
+	InventarioConcorrente *inventario;
+	int nomesPossiveis;
+	unsigned long long semente;
+	ContadoresLeitor contadores;
+} LeitorEstresse;
+
+/* Busca nomes aleatórios até o inventário ser encerrado; 1 em cada 16 buscas
+ * é sequencial, o resto binária. A flag de fim é lida sem trava: basta que a
+ * escrita chegue em algum momento, e cada busca trava uma vez só. */
+static void *lerEstresse(void *argumento) {
+	LeitorEstresse *leitor = (LeitorEstresse *)argumento;
+	InventarioConcorrente *inventario = leitor->inventario;
+	unsigned long long estado = leitor->semente;
+	while (!atomic_load_explicit(&inventario->encerrar, memory_order_relaxed)) {
+		char nome[TAM_NOME];
+		nomeSintetico(nome, (int)(proximoAleatorioDe(&estado) % (unsigned long long)leitor->nomesPossiveis));
+		Item copia;
+		int binaria = leitor->contadores.buscas % 16 != 0;
+		if (buscarConcorrente(inventario, nome, binaria, &copia, &leitor->contadores.comparacoes) >= 0) {
+			leitor->contadores.encontrados++;
+			if (strcmp(copia.nome, nome) != 0) {
+				leitor->contadores.inconsistencias++;
+			}
+		}
+		leitor->contadores.buscas++;
+	}
+	return NULL;
+}
+
+/* Roda 'leitores' threads por 'segundos'; com 'escrever', a thread chamadora
+ * insere e remove nomes aleatórios sem pausa durante o mesmo período. */
+static void faseEstresse(InventarioConcorrente *inventario, LeitorEstresse leitores[], int totalLeitores, int nomesPossiveis, double segundos, int escrever, long *escritas) {
+	pthread_t ids[MAX_THREADS_ORDENACAO];
+	int criados = 0;
+	atomic_store_explicit(&inventario->encerrar, 0, memory_order_relaxed);
+	for (; criados < totalLeitores; criados++) {
+		memset(&leitores[criados].contadores, 0, sizeof(ContadoresLeitor));
+		if (pthread_create(&ids[criados], NULL, lerEstresse, &leitores[criados]) != 0) {
+			break;
+		}
+	}
+	*escritas = 0;
+	double fim = tempoMonotonico() + segundos;
+	unsigned long long estado = 0x2545F4914F6CDD1DULL;
+	while (tempoMonotonico() < fim) {
+		if (!escrever) {
+			struct timespec pausa = {0, 1000000};
+			nanosleep(&pausa, NULL);
+			continue;
+		}
+		char nome[TAM_NOME];
+		nomeSintetico(nome, (int)(proximoAleatorioDe(&estado) % (unsigned long long)nomesPossiveis));
+		if (!inserirConcorrente(inventario, nome, "estresse", 1)) {
+			removerConcorrente(inventario, nome);
+		}
+		(*escritas)++;
+	}
+	atomic_store_explicit(&inventario->encerrar, 1, memory_order_relaxed);
+	for (int t = 0; t < criados; t++) {
+		pthread_join(ids[t], NULL);
+	}
+	for (int t = criados; t < totalLeitores; t++) {
+		memset(&leitores[t].contadores, 0, sizeof(ContadoresLeitor));
+	}
+}
+
+static void relatarFaseEstresse(const char *fase, const LeitorEstresse leitores[], int totalLeitores, double segundos, long escritas) {
+	ContadoresLeitor soma = {0};
+	for (int t = 0; t < totalLeitores; t++) {
+		soma.buscas += leitores[t].contadores.buscas;
+		soma.encontrados += leitores[t].contadores.encontrados;
+		soma.comparacoes += leitores[t].contadores.comparacoes;
+		soma.inconsistencias += leitores[t].contadores.inconsistencias;
+	}
+	printf("%-16s | %12.0f | %10.0f | %9ld | %11.1f | %ld\n", fase, soma.buscas / segundos,
+		soma.buscas / segundos / totalLeitores, soma.encontrados,
+		soma.buscas > 0 ? (double)soma.comparacoes / (double)soma.buscas : 0.0, soma.inconsistencias);
+	if (escritas > 0) {
+		printf("%-16s   escritas: %ld (%.0f/s)\n", "", escritas, escritas / segundos);
+	}
+}
+
+/* Teste de estresse: vazão dos leitores sozinhos e depois sob um escritor contínuo. */
+int executarEstresse(int totalLeitores, double segundos, int itensIniciais) {
+	if (totalLeitores < 1) totalLeitores = 1;
+	if (totalLeitores > MAX_THREADS_ORDENACAO) totalLeitores = MAX_THREADS_ORDENACAO;
+	if (segundos <= 0) segundos = 1.0;
+	if (itensIniciais < 1) itensIniciais = 1;
+	InventarioConcorrente inventario;
+	if (!iniciarInventarioConcorrente(&inventario)) {
+		return 1;
+	}
+	int nomesPossiveis = itensIniciais * 2;
+	modoSilencioso = 1;
+	reservarVetor(&inventario.vetor, itensIniciais);
+	for (int i = 0; i < nomesPossiveis; i += 2) {
+		char nome[TAM_NOME];
+		nomeSintetico(nome, i);
+		inserirConcorrente(&inventario, nome, "estresse", 1);
+	}
+	printf("Estresse: %d leitor(es), %.1f s por fase, %d itens iniciais (metade dos nomes buscados existe)\n",
+		totalLeitores, segundos, inventario.vetor.tamanho);
+	LeitorEstresse leitores[MAX_THREADS_ORDENACAO];
+	for (int t = 0; t < totalLeitores; t++) {
+		leitores[t].inventario = &inventario;
+		leitores[t].nomesPossiveis = nomesPossiveis;
+		leitores[t].semente = 0x9E3779B97F4A7C15ULL * (unsigned long long)(t + 1);
+	}
+	long escritas;
+	printf("Fase             | Buscas/s     | Por leitor | Achados   | Comp./busca | Inconsistencias\n");
+	faseEstresse(&inventario, leitores, totalLeitores, nomesPossiveis, segundos, 0, &escritas);
+	relatarFaseEstresse("so leitura", leitores, totalLeitores, segundos, 0);
+	faseEstresse(&inventario, leitores, totalLeitores, nomesPossiveis, segundos, 1, &escritas);
+	relatarFaseEstresse("com escritor", leitores, totalLeitores, segundos, escritas);
+	printf("Itens ao final: %d (ordenado: %s)\n", inventario.vetor.tamanho, inventario.ordenado ? "sim" : "nao");
+	modoSilencioso = 0;
+	liberarInventarioConcorrente(&inventario);
+	return 0;
+}
+
+/* Opção 11 do menu principal: pergunta os parâmetros e roda o teste. */
+void menuEstresse(void) {
+	int leitores;
+	int segundos;
+	int itens;
+	printf("Leitores (1-%d, 0 = %d CPUs): ", MAX_THREADS_ORDENACAO, threadsDisponiveis());
+	if (scanf("%d", &leitores) != 1) {
+		leitores = 0;
+	}
+	printf("Segundos por fase: ");
+	if (scanf("%d", &segundos) != 1) {
+		segundos = 1;
+	}
+	printf("Itens iniciais: ");
+	if (scanf("%d", &itens) != 1) {
+		itens = 10000;
+	}
+	limparBufferEntrada();
+	if (leitores < 0 || leitores > MAX_THREADS_ORDENACAO || segundos < 1 || itens < 1) {
+		printf("Leitores de 0 a %d, segundos >= 1 e itens >= 1.\n", MAX_THREADS_ORDENACAO);
+		return;
+	}
+	executarEstresse(leitores > 0 ? leitores : threadsDisponiveis(), segundos, itens);
+}
+
+/* ========== SNAPSHOT BINÁRIO ========== */
+
+/* Arquivo: cabeçalho fixo, a tabela de tipos (texto de cada id) e os
+ * registros crus (Item do vetor, Item da lista na ordem de encadeamento,
+ * Componente da torre). Os tamanhos dos registros no cabeçalho recusam
+ * arquivos gerados com outro layout. Versão 2: tipo como id internado.
+ * Versão 3: guarda o modo "manter ordenado" do vetor. */
+#define SNAPSHOT_ASSINATURA "FFSNAP1"
+#define SNAPSHOT_VERSAO 3
+
+typedef struct {
+	char assinatura[8];
+	unsigned int versao;
+	unsigned int tamanhoItem;
+	unsigned int tamanhoComponente;
+	int totalVetor;
+	int totalLista;
+	int totalTorre;
+	int vetorOrdenado;
+	int ordenadoPorNome;
+	int manterOrdenado;
+	int totalTipos;
+} CabecalhoSnapshot;
+
+/* Escreve o snapshot na posição atual do arquivo (também usado pelo diário). */
+static int gravarSnapshot(FILE *arquivo, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome) {
+	CabecalhoSnapshot cabecalho;
+	memset(&cabecalho, 0, sizeof(cabecalho));
+	memcpy(cabecalho.assinatura, SNAPSHOT_ASSINATURA, sizeof(cabecalho.assinatura));
+	cabecalho.versao = SNAPSHOT_VERSAO;
+	cabecalho.tamanhoItem = sizeof(Item);
+	cabecalho.tamanhoComponente = sizeof(Componente);
+	cabecalho.totalVetor = mochila->tamanho;
+	cabecalho.totalLista = lista->tamanho;
+	cabecalho.totalTorre = torre->total;
+	cabecalho.vetorOrdenado = vetorOrdenado;
+	cabecalho.ordenadoPorNome = ordenadoPorNome;
+	cabecalho.manterOrdenado = mochila->manterOrdenado;
+	cabecalho.totalTipos = tabelaTipos.total;
+
+	int ok = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1;
+	if (ok && tabelaTipos.total > 0) {
+		ok = fwrite(tabelaTipos.nomes, TAM_TIPO, (size_t)tabelaTipos.total, arquivo) == (size_t)tabelaTipos.total;
+	}
+	if (ok && mochila->tamanho > 0) {
+		ok = fwrite(mochila->itens, sizeof(Item), (size_t)mochila->tamanho, arquivo) == (size_t)mochila->tamanho;
+	}
+	for (const No *atual = lista->inicio; ok && atual; atual = atual->proximo) {
+		ok = fwrite(&atual->dados, sizeof(Item), 1, arquivo) == 1;
+	}
+	if (ok && torre->total > 0) {
+		ok = fwrite(torre->itens, sizeof(Componente), (size_t)torre->total, arquivo) == (size_t)torre->total;
+	}
+	return ok;
+}
+
+int salvarSnapshot(const char *caminho, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome) {
+	FILE *arquivo = fopen(caminho, "wb");
+	if (!arquivo) {
+		avisar("Nao foi possivel criar %s.\n", caminho);
+		return 0;
+	}
+	int ok = gravarSnapshot(arquivo, mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
+	if (fclose(arquivo) != 0) {
+		ok = 0;
+	}
+	if (!ok) {
+		avisar("Falha ao gravar %s.\n", caminho);
+	}
+	return ok;
+}
+
+/* Garante o '\0' final do nome e troca o id de tipo do arquivo pelo id desta execução. */
+static void ajustarRegistroSnapshot(char *nome, IdTipo *tipo, const IdTipo mapaTipos[]) {
+	nome[TAM_NOME - 1] = '\0';
+	*tipo = mapaTipos[*tipo];
+}
+
+/* Todo id de tipo dos registros precisa existir na tabela gravada. */
+static int tiposSnapshotValidos(const Item itens[], int totalItens, const Componente componentes[], int totalComponentes, int totalTipos) {
+	for (int i = 0; i < totalItens; i++) {
+		if (itens[i].tipo >= totalTipos) {
+			return 0;
+		}
+	}
+	for (int i = 0; i < totalComponentes; i++) {
+		if (componentes[i].tipo >= totalTipos) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/* Copia os registros em bloco da memória (sem parsing) para os vetores; a
+ * lista é reencadeada em uma passada pelo pool de nós. O estado atual só é
+ * substituído depois que o cabeçalho é validado. 'caminho' só nomeia a origem nos avisos. */
+static int aplicarSnapshot(const void *mapa, size_t tamanhoArquivo, const char *caminho, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome) {
+	if (tamanhoArquivo < sizeof(CabecalhoSnapshot)) {
+		avisar("Arquivo %s invalido.\n", caminho);
+		return 0;
+	}
+	const CabecalhoSnapshot *cabecalho = (const CabecalhoSnapshot *)mapa;
+	int ok = memcmp(cabecalho->assinatura, SNAPSHOT_ASSINATURA, sizeof(cabecalho->assinatura)) == 0
+		&& cabecalho->versao == SNAPSHOT_VERSAO
+		&& cabecalho->tamanhoItem == sizeof(Item)
+		&& cabecalho->tamanhoComponente == sizeof(Componente)
+		&& cabecalho->totalVetor >= 0 && cabecalho->totalLista >= 0 && cabecalho->totalTorre >= 0
+		&& cabecalho->totalTipos >= 0 && cabecalho->totalTipos <= MAX_TIPOS
+		&& tamanhoArquivo == sizeof(CabecalhoSnapshot)
+			+ (size_t)cabecalho->totalTipos * TAM_TIPO
+			+ ((size_t)cabecalho->totalVetor + (size_t)cabecalho->totalLista) * sizeof(Item)
+			+ (size_t)cabecalho->totalTorre * sizeof(Componente);
+	const char (*nomesTipos)[TAM_TIPO] = (const char (*)[TAM_TIPO])(cabecalho + 1);
+	const Item *itensVetor = (const Item *)(nomesTipos + (ok ? cabecalho->totalTipos : 0));
+	const Item *itensLista = itensVetor + (ok ? cabecalho->totalVetor : 0);
+	const Componente *componentes = (const Componente *)(itensLista + (ok ? cabecalho->totalLista : 0));
+	ok = ok && tiposSnapshotValidos(itensVetor, cabecalho->totalVetor + cabecalho->totalLista, componentes, cabecalho->totalTorre, cabecalho->totalTipos);
+	if (!ok) {
+		avisar("Snapshot %s com versao ou formato incompativel.\n", caminho);
+		return 0;
+	}
+	/* Os tipos do arquivo são reinternados; os registros recebem os ids locais. */
+	IdTipo *mapaTipos = (IdTipo *)malloc((size_t)(cabecalho->totalTipos > 0 ? cabecalho->totalTipos : 1) * sizeof(IdTipo));
+	for (int t = 0; mapaTipos && t < cabecalho->totalTipos; t++) {
+		char nomeTipoArquivo[TAM_TIPO];
+		memcpy(nomeTipoArquivo, nomesTipos[t], TAM_TIPO);
+		nomeTipoArquivo[TAM_TIPO - 1] = '\0';
+		int id = internarTipo(nomeTipoArquivo);
+		if (id < 0) {
+			free(mapaTipos);
+			mapaTipos = NULL;
+		} else {
+			mapaTipos[t] = (IdTipo)id;
+		}
+	}
+	if (!mapaTipos) {
+		avisar("Memoria insuficiente para carregar %s.\n", caminho);
+		return 0;
+	}
+
+	liberarVetor(mochila);
+	liberarLista(lista);
+	liberarComponentes(torre);
+
+	if (cabecalho->totalVetor > 0) {
+		ok = reservarVetor(mochila, cabecalho->totalVetor);
+		if (ok) {
+			memcpy(mochila->itens, itensVetor, (size_t)cabecalho->totalVetor * sizeof(Item));
+			mochila->tamanho = cabecalho->totalVetor;
+			for (int i = 0; i < mochila->tamanho; i++) {
+				ajustarRegistroSnapshot(mochila->itens[i].nome, &mochila->itens[i].tipo, mapaTipos);
+				ok = ok && inserirRadix(&mochila->radix, mochila->itens[i].nome, mochila->itens[i].quantidade);
+			}
+			reconstruirHashVetor(mochila);
+		}
+	}
+	mochila->versao++;
+	*vetorOrdenado = ok && cabecalho->vetorOrdenado;
+	/* Ligar o modo reordena se preciso: com ele ligado e o vetor fora de
+	 * ordem, as inserções anexariam no fim. */
+	mochila->manterOrdenado = 0;
+	if (ok && cabecalho->manterOrdenado) {
+		definirManterOrdenado(mochila, 1, vetorOrdenado);
+	}
+
+	if (ok && cabecalho->totalLista > 0) {
+		ok = redimensionarHash(&lista->indice, cabecalho->totalLista);
+		for (int i = 0; ok && i < cabecalho->totalLista; i++) {
+			No *novo = alocarNo(&lista->pool);
+			if (!novo) {
+				ok = 0;
+				break;
+			}
+			novo->dados = itensLista[i];
+			novo->proximo = NULL;
+			ajustarRegistroSnapshot(novo->dados.nome, &novo->dados.tipo, mapaTipos);
+			if (!inserirHash(&lista->indice, novo->dados.nome, -1, novo)) {
+				devolverNo(&lista->pool, novo);
+				continue;
+			}
+			ok = inserirRadix(&lista->radix, novo->dados.nome, novo->dados.quantidade);
+			if (lista->fim) {
+				lista->fim->proximo = novo;
+			} else {
+				lista->inicio = novo;
+			}
+			lista->fim = novo;
+			lista->tamanho++;
+		}
+	}
+
+	if (ok && cabecalho->totalTorre > 0) {
+		ok = reservarComponentes(torre, cabecalho->totalTorre);
+		if (ok) {
+			memcpy(torre->itens, componentes, (size_t)cabecalho->totalTorre * sizeof(Componente));
+			torre->total = cabecalho->totalTorre;
+			for (int i = 0; i < torre->total; i++) {
+				ajustarRegistroSnapshot(torre->itens[i].nome, &torre->itens[i].tipo, mapaTipos);
+				ok = ok && inserirRadix(&torre->radix, torre->itens[i].nome, torre->itens[i].prioridade);
+			}
+		}
+	}
+	*ordenadoPorNome = ok && cabecalho->ordenadoPorNome;
+
+	free(mapaTipos);
+	if (!ok) {
+		avisar("Memoria insuficiente para carregar %s.\n", caminho);
+	}
+	return ok;
+}
+
+/* Mapeia o arquivo com mmap e aplica o snapshot direto das páginas mapeadas. */
+int carregarSnapshot(const char *caminho, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome) {
+	int descritor = open(caminho, O_RDONLY);
+	if (descritor < 0) {
+		avisar("Nao foi possivel abrir %s.\n", caminho);
+		return 0;
+	}
+	struct stat info;
+	if (fstat(descritor, &info) != 0 || (size_t)info.st_size < sizeof(CabecalhoSnapshot)) {
+		avisar("Arquivo %s invalido.\n", caminho);
+		close(descritor);
+		return 0;
+	}
+	size_t tamanhoArquivo = (size_t)info.st_size;
+	void *mapa = mmap(NULL, tamanhoArquivo, PROT_READ, MAP_PRIVATE, descritor, 0);
+	close(descritor);
+	if (mapa == MAP_FAILED) {
+		avisar("Falha ao mapear %s.\n", caminho);
+		return 0;
+	}
+	int ok = aplicarSnapshot(mapa, tamanhoArquivo, caminho, mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
+	munmap(mapa, tamanhoArquivo);
+	return ok;
+}
+
+/* Lê o caminho e aciona salvar (opção 6) ou carregar (opção 7) com o tempo gasto. */
+void menuSnapshot(int carregar, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome) {
+	char caminho[256];
+	printf("Arquivo do snapshot: ");
+	lerLinha(caminho, sizeof(caminho));
+	if (caminho[0] == '\0') {
+		printf("Caminho vazio.\n");
+		return;
+	}
+	int ok = 0;
+	EstatisticasTempo tempo;
+	if (carregar) {
+		long long inicioNs = agoraNs();
+		ok = carregarSnapshot(caminho, mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
+		resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+	} else {
+		long long inicioNs = agoraNs();
+		ok = salvarSnapshot(caminho, mochila, *vetorOrdenado, lista, torre, *ordenadoPorNome);
+		resumirAmostraUnica(&tempo, agoraNs() - inicioNs);
+	}
+	if (ok) {
+		printf("%s: vetor %d itens, lista %d itens, torre %d componentes. ", carregar ? "Carregado" : "Salvo", mochila->tamanho, lista->tamanho, torre->total);
+		imprimirTempo(&tempo);
+	}
+	if (ok && carregar && mochila->diario) {
+		/* A carga não passa pelas operações registradas: o diário recomeça deste estado. */
+		compactarDiario(mochila->diario, mochila, *vetorOrdenado, lista, torre, *ordenadoPorNome);
+	}
+}
+
+/* ========== DIÁRIO DE OPERAÇÕES (WAL) ========== */
+
+/* Arquivo: CabecalhoDiario, o estado da última compactação como snapshot
+ * embutido (mesmo formato de salvarSnapshot, alinhado a 8 bytes) e depois os
+ * registros de tamanho fixo, só acrescentados. Um registro rasgado por uma
+ * queda não confere com a própria soma: ele e o que vier depois são
+ * descartados na recuperação. A compactação grava um arquivo novo ao lado e
+ * troca com rename(), de modo que uma queda no meio deixa o antigo intacto. */
+#define DIARIO_ASSINATURA "FFWAL01"
+#define DIARIO_VERSAO 1
+#define ALINHAR_DIARIO(n) (((n) + 7) & ~(size_t)7)
+
+typedef struct {
+	char assinatura[8];
+	unsigned int versao;
+	unsigned int tamanhoRegistro;
+	unsigned long long tamanhoSnapshot;
+} CabecalhoDiario;
+
+static void prepararCabecalhoDiario(CabecalhoDiario *cabecalho) {
+	memset(cabecalho, 0, sizeof(*cabecalho));
+	memcpy(cabecalho->assinatura, DIARIO_ASSINATURA, sizeof(cabecalho->assinatura));
+	cabecalho->versao = DIARIO_VERSAO;
+	cabecalho->tamanhoRegistro = sizeof(RegistroDiario);
+}
+
+/* FNV-1a de tudo que vem depois do campo 'verificacao' (o preenchimento é zerado). */
+static unsigned int somaRegistroDiario(const RegistroDiario *registro) {
+	const unsigned char *bytes = (const unsigned char *)registro + sizeof(registro->verificacao);
+	unsigned int soma = 2166136261u;
+	for (size_t i = 0; i < sizeof(*registro) - sizeof(registro->verificacao); i++) {
+		soma = (soma ^ bytes[i]) * 16777619u;
+	}
+	return soma;
+}
+
+static int registroDiarioValido(const RegistroDiario *registro) {
+	return registro->operacao >= DIARIO_VETOR_INSERIR && registro->operacao <= DIARIO_TORRE_LIMPAR
+		&& registro->nome[TAM_NOME - 1] == '\0' && registro->tipo[TAM_TIPO - 1] == '\0'
+		&& registro->verificacao == somaRegistroDiario(registro);
+}
+
+/* Acrescenta um registro ao lote em memória; o lote cheio vai para o disco
+ * com um write e um fsync. Sem diário (NULL) não faz nada, o que também
+ * desliga o registro enquanto o próprio diário está sendo reproduzido. */
+void registrarDiario(Diario *diario, OperacaoDiario operacao, const char *nome, const char *tipo, int valor) {
+	if (!diario || diario->falhou) {
+		return;
+	}
+	long long inicio = agoraNs();
+	RegistroDiario *registro = &diario->pendentes[diario->totalPendentes++];
+	memset(registro, 0, sizeof(*registro));
+	registro->operacao = (unsigned char)operacao;
+	memcpy(registro->nome, nome, strnlen(nome, TAM_NOME - 1));
+	memcpy(registro->tipo, tipo, strnlen(tipo, TAM_TIPO - 1));
+	registro->valor = valor;
+	registro->verificacao = somaRegistroDiario(registro);
+	diario->registrosDesdeCompactacao++;
+	if (diario->totalPendentes == DIARIO_LOTE) {
+		descarregarDiario(diario);
+	}
+	long long decorrido = agoraNs() - inicio;
+	diario->anexados++;
+	diario->tempoAnexarNs += decorrido;
+	if (decorrido > diario->maiorAnexarNs) {
+		diario->maiorAnexarNs = decorrido;
+	}
+}
+
+/* Grava o lote pendente e espera o fsync (group commit): uma alteração só é
+ * durável depois daqui. Os menus chamam isto antes de cada nova escolha. */
+int descarregarDiario(Diario *diario) {
+	if (!diario) {
+		return 1;
+	}
+	if (diario->falhou) {
+		return 0;
+	}
+	if (diario->totalPendentes == 0) {
+		return 1;
+	}
+	long long inicio = agoraNs();
+	const char *dados = (const char *)diario->pendentes;
+	size_t restante = (size_t)diario->totalPendentes * sizeof(RegistroDiario);
+	while (restante > 0) {
+		ssize_t gravados = write(diario->descritor, dados, restante);
+		if (gravados <= 0) {
+			break;
+		}
+		dados += gravados;
+		restante -= (size_t)gravados;
+	}
+	if (restante > 0 || fsync(diario->descritor) != 0) {
+		avisar("Falha ao gravar o diario %s; novas alteracoes nao serao registradas.\n", diario->caminho);
+		diario->falhou = 1;
+		return 0;
+	}
+	diario->totalPendentes = 0;
+	diario->lotesGravados++;
+	diario->tempoLotesNs += agoraNs() - inicio;
+	return 1;
+}
+
+/* Reaplica os registros com as próprias operações das estruturas. Antes, uma
+ * passada guarda o último registro de cada nome do vetor e da lista: como os
+ * nomes são únicos ali, só esse registro define o estado final, e os pares
+ * inserir/remover anteriores são pulados (a ordem final do vetor e da lista é
+ * a mesma, pois cada item reaparece na posição do seu último inserir). Na
+ * torre vale só o que vem depois do último esvaziamento; a ordem e as flags de
+ * ordenação vêm do snapshot (ver fixarOrdemDiario). Devolve quantos
+ * registros foram reaplicados, ou -1 sem memória. */
+static long reproduzirDiario(const RegistroDiario registros[], long total, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome) {
+	IndiceHash ultimoVetor = {0};
+	IndiceHash ultimaLista = {0};
+	long ultimoEsvaziamento = -1;
+	int ok = 1;
+	for (long i = 0; ok && i < total; i++) {
+		const RegistroDiario *registro = &registros[i];
+		IndiceHash *ultimos = NULL;
+		if (registro->operacao == DIARIO_VETOR_INSERIR || registro->operacao == DIARIO_VETOR_REMOVER) {
+			ultimos = &ultimoVetor;
+		} else if (registro->operacao == DIARIO_LISTA_INSERIR || registro->operacao == DIARIO_LISTA_REMOVER) {
+			ultimos = &ultimaLista;
+		} else if (registro->operacao == DIARIO_TORRE_LIMPAR) {
+			ultimoEsvaziamento = i;
+		}
+		if (ultimos) {
+			EntradaHash *entrada = buscarHash(ultimos, registro->nome, NULL);
+			if (entrada) {
+				entrada->posicao = (int)i;
+			} else {
+				ok = inserirHash(ultimos, registro->nome, (int)i, NULL);
+			}
+		}
+	}
+	long aplicados = 0;
+	for (long i = 0; ok && i < total; i++) {
+		const RegistroDiario *registro = &registros[i];
+		switch (registro->operacao) {
+			case DIARIO_VETOR_INSERIR:
+			case DIARIO_VETOR_REMOVER:
+				if (buscarHash(&ultimoVetor, registro->nome, NULL)->posicao != (int)i) {
+					continue;
+				}
+				/* Item do snapshot que o diário removeu e inseriu de novo: o remover foi pulado. */
+				if (buscarHash(&mochila->indice, registro->nome, NULL)) {
+					removerItemVetor(mochila, registro->nome, vetorOrdenado);
+				}
+				if (registro->operacao == DIARIO_VETOR_INSERIR) {
+					inserirItemVetor(mochila, registro->nome, registro->tipo, registro->valor, vetorOrdenado);
+				}
+				break;
+			case DIARIO_LISTA_INSERIR:
+			case DIARIO_LISTA_REMOVER:
+				if (buscarHash(&ultimaLista, registro->nome, NULL)->posicao != (int)i) {
+					continue;
+				}
+				if (buscarHash(&lista->indice, registro->nome, NULL)) {
+					removerItemLista(lista, registro->nome);
+				}
+				if (registro->operacao == DIARIO_LISTA_INSERIR) {
+					inserirItemLista(lista, registro->nome, registro->tipo, registro->valor);
+				}
+				break;
+			case DIARIO_TORRE_LIMPAR:
+			case DIARIO_TORRE_INSERIR:
+				if (i < ultimoEsvaziamento) {
+					continue;
+				}
+				if (registro->operacao == DIARIO_TORRE_LIMPAR) {
+					esvaziarTorre(torre);
+				} else {
+					adicionarComponente(torre, registro->nome, registro->tipo, registro->valor);
+				}
+				*ordenadoPorNome = 0;
+				break;
+		}
+		aplicados++;
+	}
+	liberarHash(&ultimoVetor);
+	liberarHash(&ultimaLista);
+	return ok ? aplicados : -1;
+}
+
+/* Valida o cabeçalho, carrega o snapshot embutido e reproduz os registros
+ * íntegros; *fimValido recebe o tamanho do trecho aproveitado do arquivo. */
+static int recuperarDiario(int descritor, size_t tamanhoArquivo, const char *caminho, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome, ResultadoDiario *resultado, size_t *fimValido) {
+	void *mapa = mmap(NULL, tamanhoArquivo, PROT_READ, MAP_PRIVATE, descritor, 0);
+	if (mapa == MAP_FAILED) {
+		avisar("Falha ao mapear %s.\n", caminho);
+		return 0;
+	}
+	const CabecalhoDiario *cabecalho = (const CabecalhoDiario *)mapa;
+	int ok = tamanhoArquivo >= sizeof(CabecalhoDiario)
+		&& memcmp(cabecalho->assinatura, DIARIO_ASSINATURA, sizeof(cabecalho->assinatura)) == 0
+		&& cabecalho->versao == DIARIO_VERSAO
+		&& cabecalho->tamanhoRegistro == sizeof(RegistroDiario)
+		&& cabecalho->tamanhoSnapshot <= tamanhoArquivo - sizeof(CabecalhoDiario);
+	if (!ok) {
+		avisar("Diario %s com versao ou formato incompativel.\n", caminho);
+		munmap(mapa, tamanhoArquivo);
+		return 0;
+	}
+	const unsigned char *bytes = (const unsigned char *)mapa;
+	size_t inicioRegistros = sizeof(CabecalhoDiario) + ALINHAR_DIARIO((size_t)cabecalho->tamanhoSnapshot);
+	if (cabecalho->tamanhoSnapshot > 0) {
+		resultado->tinhaSnapshot = 1;
+		ok = aplicarSnapshot(bytes + sizeof(CabecalhoDiario), (size_t)cabecalho->tamanhoSnapshot, caminho,
+			mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
+	}
+	long total = 0;
+	if (ok && inicioRegistros <= tamanhoArquivo) {
+		const RegistroDiario *registros = (const RegistroDiario *)(bytes + inicioRegistros);
+		long disponiveis = (long)((tamanhoArquivo - inicioRegistros) / sizeof(RegistroDiario));
+		while (total < disponiveis && registroDiarioValido(&registros[total])) {
+			total++;
+		}
+		resultado->registros = total;
+		resultado->aplicados = reproduzirDiario(registros, total, mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
+		ok = resultado->aplicados >= 0;
+		*fimValido = inicioRegistros + (size_t)total * sizeof(RegistroDiario);
+	} else {
+		*fimValido = tamanhoArquivo;
+	}
+	munmap(mapa, tamanhoArquivo);
+	if (!ok) {
+		avisar("Falha ao recuperar o diario %s.\n", caminho);
+	}
+	return ok;
+}
+
+/* Abre (ou cria) o diário, recupera o estado gravado nas estruturas vazias,
+ * trunca uma cauda corrompida e só então liga o registro nas três estruturas. */
+int abrirDiario(Diario *diario, const char *caminho, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome, ResultadoDiario *resultado) {
+	memset(diario, 0, sizeof(*diario));
+	memset(resultado, 0, sizeof(*resultado));
+	diario->descritor = -1;
+	if (strlen(caminho) >= sizeof(diario->caminho)) {
+		avisar("Caminho do diario muito longo.\n");
+		return 0;
+	}
+	strcpy(diario->caminho, caminho);
+	double inicio = tempoMonotonico();
+	int descritor = open(caminho, O_RDWR | O_CREAT | O_APPEND, 0644);
+	struct stat info;
+	if (descritor < 0 || fstat(descritor, &info) != 0) {
+		avisar("Nao foi possivel abrir o diario %s.\n", caminho);
+		if (descritor >= 0) {
+			close(descritor);
+		}
+		return 0;
+	}
+	size_t tamanhoArquivo = (size_t)info.st_size;
+	int ok;
+	if (tamanhoArquivo == 0) {
+		CabecalhoDiario cabecalho;
+		prepararCabecalhoDiario(&cabecalho);
+		ok = write(descritor, &cabecalho, sizeof(cabecalho)) == (ssize_t)sizeof(cabecalho) && fsync(descritor) == 0;
+		if (!ok) {
+			avisar("Falha ao gravar o diario %s.\n", caminho);
+		}
+	} else {
+		size_t fimValido = tamanhoArquivo;
+		ok = recuperarDiario(descritor, tamanhoArquivo, caminho, mochila, vetorOrdenado, lista, torre, ordenadoPorNome, resultado, &fimValido);
+		if (ok && fimValido < tamanhoArquivo) {
+			resultado->bytesDescartados = (long)(tamanhoArquivo - fimValido);
+			ok = ftruncate(descritor, (off_t)fimValido) == 0 && fsync(descritor) == 0;
+		}
+	}
+	resultado->segundos = tempoMonotonico() - inicio;
+	if (!ok) {
+		close(descritor);
+		return 0;
+	}
+	diario->descritor = descritor;
+	mochila->diario = diario;
+	lista->diario = diario;
+	torre->diario = diario;
+	return 1;
+}
+
+/* fsync do diretório para que o rename() da compactação sobreviva a uma queda. */
+static void sincronizarDiretorio(const char *caminho) {
+	char diretorio[256];
+	const char *barra = strrchr(caminho, '/');
+	if (!barra) {
+		strcpy(diretorio, ".");
+	} else {
+		size_t tamanho = barra == caminho ? 1 : (size_t)(barra - caminho);
+		memcpy(diretorio, caminho, tamanho);
+		diretorio[tamanho] = '\0';
+	}
+	int descritor = open(diretorio, O_RDONLY);
+	if (descritor >= 0) {
+		fsync(descritor);
+		close(descritor);
+	}
+}
+
+/* Grava o estado atual como snapshot embutido de um diário vazio e o troca
+ * pelo atual: os registros acumulados deixam de ser necessários. */
+int compactarDiario(Diario *diario, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome) {
+	if (!descarregarDiario(diario)) {
+		return 0;
+	}
+	char temporario[sizeof(diario->caminho) + sizeof(".tmp")];
+	snprintf(temporario, sizeof(temporario), "%s.tmp", diario->caminho);
+	FILE *arquivo = fopen(temporario, "wb");
+	if (!arquivo) {
+		avisar("Nao foi possivel criar %s.\n", temporario);
+		return 0;
+	}
+	CabecalhoDiario cabecalho;
+	prepararCabecalhoDiario(&cabecalho);
+	int ok = fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1
+		&& gravarSnapshot(arquivo, mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
+	long fimSnapshot = ok ? ftell(arquivo) : -1;
+	if (fimSnapshot >= (long)sizeof(cabecalho)) {
+		static const char zeros[8] = {0};
+		cabecalho.tamanhoSnapshot = (unsigned long long)fimSnapshot - sizeof(cabecalho);
+		size_t preenchimento = ALINHAR_DIARIO((size_t)cabecalho.tamanhoSnapshot) - (size_t)cabecalho.tamanhoSnapshot;
+		ok = fwrite(zeros, 1, preenchimento, arquivo) == preenchimento
+			&& fseek(arquivo, 0, SEEK_SET) == 0
+			&& fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1
+			&& fflush(arquivo) == 0
+			&& fsync(fileno(arquivo)) == 0;
+	} else {
+		ok = 0;
+	}
+	if (fclose(arquivo) != 0) {
+		ok = 0;
+	}
+	int descritor = -1;
+	if (ok && rename(temporario, diario->caminho) == 0) {
+		sincronizarDiretorio(diario->caminho);
+		descritor = open(diario->caminho, O_WRONLY | O_APPEND);
+	} else {
+		remove(temporario);
+	}
+	if (descritor < 0) {
+		avisar("Falha ao compactar o diario %s.\n", diario->caminho);
 		return 0;
 	}
-	for (int i = idx; i < (*tamanho) - 1; i++) {
-		mochila[i] = mochila[i + 1];
-	}
-	(*tamanho)--;
-	*ordenado = 0;
+	close(diario->descritor);
+	diario->descritor = descritor;
+	diario->registrosDesdeCompactacao = 0;
+	diario->compactacoes++;
 	return 1;
 }
 
-/* Exibe inventário armazenado no vetor. */
-void listarItensVetor(const Item mochila[], int tamanho) {
-	printf("\nItens no vetor (%d/%d):\n", tamanho, CAPACIDADE_MAXIMA);
-	if (tamanho == 0) {
-		printf("(vazio)\n");
+/* Chamada entre operações: grava o lote parcial e compacta quando o diário
+ * passou de DIARIO_COMPACTAR_APOS registros. */
+void manterDiario(Diario *diario, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome) {
+	if (!diario) {
 		return;
 	}
-	for (int i = 0; i < tamanho; i++) {
-		printf("%d) %s | %s | qtd %d\n", i + 1, mochila[i].nome, mochila[i].tipo, mochila[i].quantidade);
+	descarregarDiario(diario);
+	if (diario->registrosDesdeCompactacao >= DIARIO_COMPACTAR_APOS) {
+		compactarDiario(diario, mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
 	}
 }
 
-/* Busca sequencial no vetor com contador de comparações. */
-int buscarSequencialVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes) {
-	for (int i = 0; i < tamanho; i++) {
-		(*comparacoes)++;
-		if (strcmp(mochila[i].nome, nome) == 0) {
-			return i;
-		}
+/* Ordenações, visões aplicadas e o modo "manter ordenado" não têm registro
+ * próprio: o estado reordenado vira o snapshot do diário na hora, e a
+ * recuperação já parte dele (ordem física e flags de ordenação inclusas). */
+void fixarOrdemDiario(Diario *diario, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, const VetorComponentes *torre, int ordenadoPorNome) {
+	if (diario) {
+		compactarDiario(diario, mochila, vetorOrdenado, lista, torre, ordenadoPorNome);
 	}
-	return -1;
 }
 
-/* Bubble sort por nome para habilitar busca binária. */
-int ordenarVetor(Item mochila[], int tamanho) {
-	if (tamanho < 2) {
-		return 0;
+void fecharDiario(Diario *diario) {
+	descarregarDiario(diario);
+	if (diario->descritor >= 0) {
+		close(diario->descritor);
+		diario->descritor = -1;
 	}
-	for (int i = 0; i < tamanho - 1; i++) {
-		for (int j = 0; j < tamanho - i - 1; j++) {
-			if (strcmp(mochila[j].nome, mochila[j + 1].nome) > 0) {
-				Item tmp = mochila[j];
-				mochila[j] = mochila[j + 1];
-				mochila[j + 1] = tmp;
-			}
-		}
+}
+
+void mostrarResultadoDiario(const char *caminho, const ResultadoDiario *resultado) {
+	printf("Diario %s: snapshot %s, %ld registro(s) (%ld reaplicados) em %.3f s (%.0f registros/s)\n", caminho,
+		resultado->tinhaSnapshot ? "carregado" : "vazio", resultado->registros, resultado->aplicados, resultado->segundos,
+		resultado->segundos > 0 ? resultado->registros / resultado->segundos : 0.0);
+	if (resultado->bytesDescartados > 0) {
+		printf("Cauda incompleta ou corrompida descartada: %ld bytes\n", resultado->bytesDescartados);
 	}
-	return 1;
 }
 
-/* Busca binária no vetor ordenado, contando comparações. */
-int buscarBinariaVetor(const Item mochila[], int tamanho, const char *nome, long *comparacoes) {
-	int inicio = 0;
-	int fim = tamanho - 1;
-	while (inicio <= fim) {
-		int meio = (inicio + fim) / 2;
-		(*comparacoes)++;
-		int cmp = strcmp(mochila[meio].nome, nome);
-		if (cmp == 0) {
-			return meio;
-		} else if (cmp < 0) {
-			inicio = meio + 1;
-		} else {
-			fim = meio - 1;
-		}
+/* Latência de acréscimo (inclui o fsync do lote que enche) e custo por lote. */
+void mostrarEstatisticasDiario(const Diario *diario) {
+	printf("Diario %s: %ld registro(s) anexados | media %.0f ns, maior %lld ns por registro\n", diario->caminho,
+		diario->anexados, diario->anexados > 0 ? (double)diario->tempoAnexarNs / diario->anexados : 0.0, diario->maiorAnexarNs);
+	printf("Lotes gravados com fsync: %ld (media %.0f us) | pendentes: %d | desde a compactacao: %ld | compactacoes: %ld%s\n",
+		diario->lotesGravados, diario->lotesGravados > 0 ? diario->tempoLotesNs / 1000.0 / diario->lotesGravados : 0.0,
+		diario->totalPendentes, diario->registrosDesdeCompactacao, diario->compactacoes, diario->falhou ? " | FALHOU" : "");
+}
+
+/* ========== IMPORTAÇÃO / EXPORTAÇÃO CSV ========== */
+
+/* CSV simples, sem aspas: nome,tipo,quantidade (vetor e lista) ou
+ * nome,tipo,prioridade (torre). Uma linha de cabeçalho iniciada por "nome,"
+ * é ignorada. Cada linha é quebrada no próprio buffer de leitura e inserida
+ * direto na estrutura, sem cópia intermediária do arquivo. */
+#define CSV_BUFFER (1 << 20)
+
+/* Igual a proximoCampo, com separador escolhido pelo chamador. */
+static char *separarCampo(char **cursor, char separador) {
+	char *inicio = *cursor;
+	if (inicio == NULL) {
+		return NULL;
 	}
-	return -1;
+	char *fimCampo = strchr(inicio, separador);
+	if (fimCampo) {
+		*fimCampo = '\0';
+		*cursor = fimCampo + 1;
+	} else {
+		*cursor = NULL;
+	}
+	return inicio;
 }
 
-/* Insere novo nó ao final da lista encadeada (custo linear). */
-int inserirItemLista(No **inicio, const char *nome, const char *tipo, int quantidade) {
-	if (quantidade <= 0) {
-		printf("Quantidade deve ser positiva.\n");
+int importarCsv(const char *caminho, DestinoCsv destino, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome, ResultadoCsv *resultado) {
+	memset(resultado, 0, sizeof(*resultado));
+	FILE *arquivo = fopen(caminho, "r");
+	if (!arquivo) {
+		avisar("Nao foi possivel abrir %s.\n", caminho);
 		return 0;
 	}
-	No *novo = (No *)malloc(sizeof(No));
-	if (!novo) {
-		printf("Falha ao alocar memoria.\n");
-		return 0;
+	char *buffer = (char *)malloc(CSV_BUFFER);
+	if (buffer) {
+		setvbuf(arquivo, buffer, _IOFBF, CSV_BUFFER);
 	}
-	strncpy(novo->dados.nome, nome, TAM_NOME - 1);
-	novo->dados.nome[TAM_NOME - 1] = '\0';
-	strncpy(novo->dados.tipo, tipo, TAM_TIPO - 1);
-	novo->dados.tipo[TAM_TIPO - 1] = '\0';
-	novo->dados.quantidade = quantidade;
-	novo->proximo = NULL;
 
-	if (*inicio == NULL) {
-		*inicio = novo;
-		return 1;
+	if (destino == CSV_TORRE) {
+		/* Carga em massa: mais barato remontar as visões depois do que encaixar linha a linha. */
+		invalidarVisoes(torre);
 	}
-	No *atual = *inicio;
-	while (atual->proximo) {
-		atual = atual->proximo;
-	}
-	atual->proximo = novo;
-	return 1;
-}
+	int silencioAnterior = modoSilencioso;
+	modoSilencioso = 1;
+	char linha[256];
+	double inicio = tempoMonotonico();
+	while (fgets(linha, sizeof(linha), arquivo)) {
+		size_t len = strcspn(linha, "\r\n");
+		if (linha[len] == '\0' && !feof(arquivo)) {
+			/* Linha maior que o buffer: descarta o restante e rejeita. */
+			int c;
+			while ((c = fgetc(arquivo)) != '\n' && c != EOF) {
+			}
+			resultado->linhas++;
+			resultado->rejeitadas++;
+			continue;
+		}
+		linha[len] = '\0';
+		if (len == 0) {
+			continue;
+		}
+		if (resultado->linhas == 0 && resultado->rejeitadas == 0 && strncmp(linha, "nome,", 5) == 0) {
+			continue;
+		}
+		resultado->linhas++;
 
-/* Remove nó pelo nome ajustando encadeamento. */
-int removerItemLista(No **inicio, const char *nome) {
-	No *anterior = NULL;
-	No *atual = *inicio;
-	while (atual) {
-		if (strcmp(atual->dados.nome, nome) == 0) {
-			if (anterior == NULL) {
-				*inicio = atual->proximo;
+		char *cursor = linha;
+		char *nome = separarCampo(&cursor, ',');
+		char *tipo = separarCampo(&cursor, ',');
+		char *numero = separarCampo(&cursor, ',');
+		int valor;
+		int ok = nome && tipo && numero && cursor == NULL && nome[0] != '\0' && lerInteiroCampo(numero, &valor);
+		if (ok) {
+			if (destino == CSV_VETOR) {
+				ok = inserirItemVetor(mochila, nome, tipo, valor, vetorOrdenado);
+			} else if (destino == CSV_LISTA) {
+				ok = inserirItemLista(lista, nome, tipo, valor);
 			} else {
-				anterior->proximo = atual->proximo;
+				ok = adicionarComponente(torre, nome, tipo, valor);
+				if (ok) {
+					*ordenadoPorNome = 0;
+				}
 			}
-			free(atual);
-			return 1;
 		}
-		anterior = atual;
-		atual = atual->proximo;
+		if (ok) {
+			resultado->aceitas++;
+		} else {
+			resultado->rejeitadas++;
+		}
 	}
-	printf("Item nao encontrado.\n");
-	return 0;
+	resultado->segundos = tempoMonotonico() - inicio;
+	modoSilencioso = silencioAnterior;
+	fclose(arquivo);
+	free(buffer);
+	return 1;
 }
 
-/* Percorre e exibe a lista encadeada. */
-void listarItensLista(const No *inicio) {
-	printf("\nItens na lista: \n");
-	if (!inicio) {
-		printf("(vazio)\n");
-		return;
+/* Grava a estrutura inteira; registros com ',' no nome ou tipo não caberiam
+ * no formato sem aspas e são contados como rejeitados. */
+int exportarCsv(const char *caminho, DestinoCsv destino, const VetorItens *mochila, const ListaItens *lista, const VetorComponentes *torre, ResultadoCsv *resultado) {
+	memset(resultado, 0, sizeof(*resultado));
+	FILE *arquivo = fopen(caminho, "w");
+	if (!arquivo) {
+		avisar("Nao foi possivel criar %s.\n", caminho);
+		return 0;
 	}
-	int idx = 1;
-	while (inicio) {
-		printf("%d) %s | %s | qtd %d\n", idx, inicio->dados.nome, inicio->dados.tipo, inicio->dados.quantidade);
-		inicio = inicio->proximo;
-		idx++;
+	char *buffer = (char *)malloc(CSV_BUFFER);
+	if (buffer) {
+		setvbuf(arquivo, buffer, _IOFBF, CSV_BUFFER);
 	}
-}
 
-/* Busca sequencial na lista com contagem de comparações. */
-No *buscarSequencialLista(const No *inicio, const char *nome, long *comparacoes) {
-	while (inicio) {
-		(*comparacoes)++;
-		if (strcmp(inicio->dados.nome, nome) == 0) {
-			return (No *)inicio;
+	double inicio = tempoMonotonico();
+	fprintf(arquivo, destino == CSV_TORRE ? "nome,tipo,prioridade\n" : "nome,tipo,quantidade\n");
+	if (destino == CSV_TORRE) {
+		for (int i = 0; i < torre->total; i++) {
+			const Componente *c = &torre->itens[i];
+			resultado->linhas++;
+			if (strchr(c->nome, ',') || strchr(nomeTipo(c->tipo), ',')) {
+				resultado->rejeitadas++;
+				continue;
+			}
+			fprintf(arquivo, "%s,%s,%d\n", c->nome, nomeTipo(c->tipo), c->prioridade);
+			resultado->aceitas++;
+		}
+	} else {
+		const No *atual = destino == CSV_LISTA ? lista->inicio : NULL;
+		int total = destino == CSV_VETOR ? mochila->tamanho : 0;
+		for (int i = 0; i < total || atual; i++) {
+			const Item *item = atual ? &atual->dados : &mochila->itens[i];
+			if (atual) {
+				atual = atual->proximo;
+			}
+			resultado->linhas++;
+			if (strchr(item->nome, ',') || strchr(nomeTipo(item->tipo), ',')) {
+				resultado->rejeitadas++;
+				continue;
+			}
+			fprintf(arquivo, "%s,%s,%d\n", item->nome, nomeTipo(item->tipo), item->quantidade);
+			resultado->aceitas++;
 		}
-		inicio = inicio->proximo;
 	}
-	return NULL;
-}
-
-/* Libera nós alocados dinamicamente para evitar vazamento. */
-void liberarLista(No **inicio) {
-	No *atual = *inicio;
-	while (atual) {
-		No *prox = atual->proximo;
-		free(atual);
-		atual = prox;
+	int ok = fclose(arquivo) == 0;
+	resultado->segundos = tempoMonotonico() - inicio;
+	free(buffer);
+	if (!ok) {
+		avisar("Falha ao gravar %s.\n", caminho);
 	}
-	*inicio = NULL;
+	return ok;
 }
 
-/* ========== MÓDULO TORRE DE FUGA ========== */
-
-/* Menu do módulo Torre de Fuga */
-int menuTorreFuga(void) {
-	int opcao;
-	printf("\n=== TORRE DE FUGA - DESAFIO FINAL ===\n");
-	printf("1) Cadastrar componentes\n");
-	printf("2) Ordenar por NOME (Bubble Sort)\n");
-	printf("3) Ordenar por TIPO (Insertion Sort)\n");
-	printf("4) Ordenar por PRIORIDADE (Selection Sort)\n");
-	printf("5) Buscar componente-chave (Busca Binaria)\n");
-	printf("6) Listar componentes\n");
-	printf("0) Voltar\n");
-	printf("Escolha: ");
-	if (scanf("%d", &opcao) != 1) {
-		opcao = 0;
-	}
-	limparBufferEntrada();
-	return opcao;
+void mostrarResultadoCsv(const char *operacao, const ResultadoCsv *resultado) {
+	printf("%s: %ld linhas, %ld aceitas, %ld rejeitadas em %.6f s (%.0f linhas/s)\n",
+		operacao, resultado->linhas, resultado->aceitas, resultado->rejeitadas, resultado->segundos,
+		resultado->segundos > 0 ? resultado->linhas / resultado->segundos : 0.0);
 }
 
-/* Cadastra componentes da torre com nome, tipo e prioridade */
-void cadastrarComponentes(Componente componentes[], int *total) {
-	int quantidade;
-	printf("\n>>> CADASTRO DE COMPONENTES <<<\n");
-	printf("Quantos componentes deseja cadastrar? (max %d): ", MAX_COMPONENTES);
-	if (scanf("%d", &quantidade) != 1 || quantidade <= 0) {
-		printf("Quantidade invalida.\n");
+/* Opções 8 (importar) e 9 (exportar) do menu principal. */
+void menuCsv(int exportar, VetorItens *mochila, int *vetorOrdenado, ListaItens *lista, VetorComponentes *torre, int *ordenadoPorNome) {
+	int destino;
+	printf("Estrutura (1-Vetor, 2-Lista, 3-Torre): ");
+	if (scanf("%d", &destino) != 1 || destino < CSV_VETOR || destino > CSV_TORRE) {
+		printf("Estrutura invalida.\n");
 		limparBufferEntrada();
 		return;
 	}
 	limparBufferEntrada();
-	if (quantidade > MAX_COMPONENTES) {
-		quantidade = MAX_COMPONENTES;
-		printf("Limitado a %d componentes.\n", MAX_COMPONENTES);
+	char caminho[256];
+	printf("Arquivo CSV: ");
+	lerLinha(caminho, sizeof(caminho));
+	if (caminho[0] == '\0') {
+		printf("Caminho vazio.\n");
+		return;
 	}
-	*total = 0;
-	for (int i = 0; i < quantidade; i++) {
-		printf("\n--- Componente %d ---\n", i + 1);
-		printf("Nome: ");
-		lerLinha(componentes[*total].nome, TAM_NOME);
-		printf("Tipo (controle/suporte/propulsao): ");
-		lerLinha(componentes[*total].tipo, TAM_TIPO);
-		printf("Prioridade (1-10): ");
-		if (scanf("%d", &componentes[*total].prioridade) != 1) {
-			printf("Prioridade invalida, definindo como 1.\n");
-			componentes[*total].prioridade = 1;
+	ResultadoCsv resultado;
+	if (exportar) {
+		if (exportarCsv(caminho, (DestinoCsv)destino, mochila, lista, torre, &resultado)) {
+			mostrarResultadoCsv("Exportacao", &resultado);
 		}
-		limparBufferEntrada();
-		if (componentes[*total].prioridade < 1 || componentes[*total].prioridade > 10) {
-			if (componentes[*total].prioridade < 1) componentes[*total].prioridade = 1;
-			if (componentes[*total].prioridade > 10) componentes[*total].prioridade = 10;
-		}
-		(*total)++;
+	} else if (importarCsv(caminho, (DestinoCsv)destino, mochila, vetorOrdenado, lista, torre, ordenadoPorNome, &resultado)) {
+		mostrarResultadoCsv("Importacao", &resultado);
 	}
-	printf("\n%d componentes cadastrados!\n", *total);
 }
 
-/* Bubble Sort: ordena componentes por NOME (ordem alfabética) */
-void bubbleSortNome(Componente componentes[], int total, long *comparacoes) {
-	*comparacoes = 0;
-	for (int i = 0; i < total - 1; i++) {
-		for (int j = 0; j < total - i - 1; j++) {
-			(*comparacoes)++;
-			if (strcmp(componentes[j].nome, componentes[j + 1].nome) > 0) {
-				Componente temp = componentes[j];
-				componentes[j] = componentes[j + 1];
-				componentes[j + 1] = temp;
-			}
-		}
-	}
+/* ========== MODO LOTE (SCRIPT) ========== */
+
+/* Separa o próximo campo delimitado por ';' (modifica a linha in-place). */
+static char *proximoCampo(char **cursor) {
+	return separarCampo(cursor, ';');
 }
 
-/* Insertion Sort: ordena componentes por TIPO (ordem alfabética) */
-void insertionSortTipo(Componente componentes[], int total, long *comparacoes) {
-	*comparacoes = 0;
-	for (int i = 1; i < total; i++) {
-		Componente chave = componentes[i];
-		int j = i - 1;
-		while (j >= 0) {
-			(*comparacoes)++;
-			if (strcmp(componentes[j].tipo, chave.tipo) > 0) {
-				componentes[j + 1] = componentes[j];
-				j--;
-			} else {
-				break;
-			}
-		}
-		componentes[j + 1] = chave;
+/* "prefixo <p>" ou "intervalo <de>;<ate>" (os campos apontam para a própria linha). */
+static int lerFaixaScript(const char *comando, char *argumentos, FaixaNomes *faixa) {
+	if (strcmp(comando, "prefixo") == 0) {
+		*faixa = faixaPrefixo(argumentos);
+		return 1;
+	}
+	char *cursor = argumentos;
+	char *de = proximoCampo(&cursor);
+	char *ate = proximoCampo(&cursor);
+	if (!de || !ate) {
+		return 0;
 	}
+	*faixa = faixaIntervalo(de, ate);
+	return 1;
 }
 
-/* Selection Sort: ordena componentes por PRIORIDADE (ordem crescente) */
-void selectionSortPrioridade(Componente componentes[], int total, long *comparacoes) {
-	*comparacoes = 0;
-	for (int i = 0; i < total - 1; i++) {
-		int indiceMinimo = i;
-		for (int j = i + 1; j < total; j++) {
-			(*comparacoes)++;
-			if (componentes[j].prioridade < componentes[indiceMinimo].prioridade) {
-				indiceMinimo = j;
-			}
-		}
-		if (indiceMinimo != i) {
-			Componente temp = componentes[i];
-			componentes[i] = componentes[indiceMinimo];
-			componentes[indiceMinimo] = temp;
-		}
+/* "radix <nome>", "completar <prefixo>" ou "topk <prefixo>"; -1 se o comando for outro. */
+static int comandoRadixScript(const ArvoreRadix *arvore, const char *comando, const char *argumentos, long *nosVisitados) {
+	SugestaoRadix sugestoes[MAX_SUGESTOES];
+	long encontrados;
+	if (strcmp(comando, "radix") == 0) {
+		return buscarRadix(arvore, argumentos, NULL, nosVisitados);
+	} else if (strcmp(comando, "completar") == 0 || strcmp(comando, "topk") == 0) {
+		return completarRadix(arvore, argumentos, comando[0] == 't', sugestoes, MAX_SUGESTOES, &encontrados, nosVisitados) > 0;
 	}
+	return -1;
 }
 
-/* Busca Binária: busca componente por NOME (requer ordenação prévia por nome) */
-int buscaBinariaPorNome(Componente componentes[], int total, const char *nomeBuscado, long *comparacoes) {
-	*comparacoes = 0;
-	int inicio = 0;
-	int fim = total - 1;
-	while (inicio <= fim) {
-		int meio = inicio + (fim - inicio) / 2;
-		(*comparacoes)++;
-		int cmp = strcmp(componentes[meio].nome, nomeBuscado);
-		if (cmp == 0) {
-			return meio;
-		} else if (cmp < 0) {
-			inicio = meio + 1;
+/* "<estrutura> lote <arquivo>": 1 se algum nome foi encontrado. */
+static int executarLoteScript(DestinoCsv destino, const char *caminho, const VetorItens *mochila, int vetorOrdenado, const ListaItens *lista, VetorComponentes *torre, long *comparacoes, long *buscas) {
+	LoteNomes lote = {0};
+	int encontrados = 0;
+	int *posicoes = NULL;
+	const No **nos = NULL;
+	if (lerLoteNomes(caminho, &lote) && lote.total > 0) {
+		posicoes = (int *)malloc((size_t)lote.total * sizeof(int));
+		nos = (const No **)malloc((size_t)lote.total * sizeof(No *));
+	}
+	if (posicoes && nos) {
+		if (destino == CSV_VETOR) {
+			encontrados = buscarLoteVetor(mochila, vetorOrdenado, &lote, posicoes, threadsDisponiveis(), comparacoes);
+		} else if (destino == CSV_LISTA) {
+			encontrados = buscarLoteLista(lista, &lote, nos, threadsDisponiveis(), comparacoes);
 		} else {
-			fim = meio - 1;
+			encontrados = buscarLoteTorre(torre, &lote, posicoes, comparacoes);
 		}
+		*buscas += lote.total;
 	}
-	return -1;
+	free(posicoes);
+	free(nos);
+	liberarLoteNomes(&lote);
+	return encontrados > 0;
 }
 
-/* Exibe todos os componentes da torre formatados */
-void mostrarComponentes(const Componente componentes[], int total) {
-	printf("\n=== COMPONENTES DA TORRE (%d/%d) ===\n", total, MAX_COMPONENTES);
-	if (total == 0) {
-		printf("(Nenhum componente cadastrado)\n");
-		return;
+/* Executa um arquivo de operações sem listagens e imprime resumo + vazão.
+ * Com 'caminhoDiario', parte do estado recuperado do diário e registra nele. */
+int executarScript(const char *caminho, const char *caminhoDiario) {
+	FILE *arquivo = fopen(caminho, "r");
+	if (!arquivo) {
+		fprintf(stderr, "Nao foi possivel abrir %s\n", caminho);
+		return 1;
 	}
-	printf("%-4s %-25s %-18s %s\n", "#", "NOME", "TIPO", "PRIORIDADE");
-	printf("---------------------------------------------------\n");
-	for (int i = 0; i < total; i++) {
-		printf("%-4d %-25s %-18s %d\n", i + 1, componentes[i].nome, componentes[i].tipo, componentes[i].prioridade);
+	static char bufferArquivo[1 << 16];
+	setvbuf(arquivo, bufferArquivo, _IOFBF, sizeof(bufferArquivo));
+
+	VetorItens mochilaVetor = {0};
+	MochilaSoA mochilaSoA = {0};
+	int vetorOrdenado = 0;
+	ListaItens lista = {0};
+	ListaDesenrolada desenrolada = {0};
+	VetorComponentes torre = {0};
+	int ordenadoPorNome = 0;
+
+	long operacoes = 0;
+	long falhas = 0;
+	long invalidas = 0;
+	long comparacoes = 0;
+	long sondagens = 0;
+	long nosVisitados = 0;
+	long numeroLinha = 0;
+	long linhasCsv = 0;
+	long rejeitadasCsv = 0;
+	long movimentos = 0;
+	long nosRadix = 0;
+	long buscasLote = 0;
+	char linha[256];
+	Diario diario;
+
+	if (caminhoDiario) {
+		ResultadoDiario recuperado;
+		if (!abrirDiario(&diario, caminhoDiario, &mochilaVetor, &vetorOrdenado, &lista, &torre, &ordenadoPorNome, &recuperado)) {
+			fclose(arquivo);
+			liberarVetor(&mochilaVetor);
+			liberarLista(&lista);
+			liberarComponentes(&torre);
+			liberarTabelaTipos();
+			return 1;
+		}
+		mostrarResultadoDiario(caminhoDiario, &recuperado);
 	}
-	printf("===================================================\n");
-}
+	modoSilencioso = 1;
+	double inicio = tempoMonotonico();
+	while (fgets(linha, sizeof(linha), arquivo)) {
+		numeroLinha++;
+		size_t len = strcspn(linha, "\r\n");
+		linha[len] = '\0';
+		if (linha[0] == '\0' || linha[0] == '#') {
+			continue;
+		}
 
-/* Mede o tempo de execução de um algoritmo de ordenação */
-double medirTempoOrdenacao(void (*algoritmo)(Componente[], int, long*), Componente componentes[], int total, long *comparacoes) {
-	clock_t inicio = clock();
-	algoritmo(componentes, total, comparacoes);
-	clock_t fim = clock();
-	return (double)(fim - inicio) / CLOCKS_PER_SEC;
-}
+		char *estrutura = linha;
+		char *comando = strchr(estrutura, ' ');
+		if (!comando) {
+			comando = estrutura + len;
+		} else {
+			*comando++ = '\0';
+		}
+		char *argumentos = strchr(comando, ' ');
+		if (argumentos) {
+			*argumentos++ = '\0';
+		} else {
+			argumentos = comando + strlen(comando);
+		}
+
+		int ok = -1;
+		int reordenou = 0;
+		DestinoCsv destinoCsv = strcmp(estrutura, "vetor") == 0 ? CSV_VETOR
+			: strcmp(estrutura, "lista") == 0 ? CSV_LISTA
+			: strcmp(estrutura, "torre") == 0 ? CSV_TORRE : (DestinoCsv)0;
+		if (destinoCsv && (strcmp(comando, "importar") == 0 || strcmp(comando, "exportar") == 0)) {
+			ResultadoCsv resultado;
+			if (comando[0] == 'i') {
+				ok = importarCsv(argumentos, destinoCsv, &mochilaVetor, &vetorOrdenado, &lista, &torre, &ordenadoPorNome, &resultado);
+				linhasCsv += resultado.linhas;
+				rejeitadasCsv += resultado.rejeitadas;
+			} else {
+				ok = exportarCsv(argumentos, destinoCsv, &mochilaVetor, &lista, &torre, &resultado);
+			}
+		} else if (destinoCsv && strcmp(comando, "lote") == 0) {
+			ok = executarLoteScript(destinoCsv, argumentos, &mochilaVetor, vetorOrdenado, &lista, &torre, &comparacoes, &buscasLote);
+		} else if (strcmp(estrutura, "vetor") == 0) {
+			if (strcmp(comando, "inserir") == 0) {
+				char *cursor = argumentos;
+				char *nome = proximoCampo(&cursor);
+				char *tipo = proximoCampo(&cursor);
+				char *qtd = proximoCampo(&cursor);
+				int quantidade;
+				if (nome && tipo && qtd && lerInteiroCampo(qtd, &quantidade) && quantidade > 0) {
+					ok = inserirItemVetor(&mochilaVetor, nome, tipo, quantidade, &vetorOrdenado);
+				}
+			} else if (strcmp(comando, "remover") == 0) {
+				ok = removerItemVetor(&mochilaVetor, argumentos, &vetorOrdenado);
+			} else if (strcmp(comando, "buscar") == 0) {
+				ok = buscarSequencialVetor(mochilaVetor.itens, mochilaVetor.tamanho, argumentos, &comparacoes) >= 0;
+			} else if (strcmp(comando, "ordenar") == 0) {
+				ordenarVetor(&mochilaVetor, &comparacoes);
+				vetorOrdenado = 1;
+				reordenou = 1;
+				ok = 1;
+			} else if (strcmp(comando, "paralelo") == 0) {
+				int totalThreads = threadsDisponiveis();
+				if (argumentos[0] == '\0' || (lerInteiroCampo(argumentos, &totalThreads) && totalThreads > 0)) {
+					ordenarVetorParalelo(&mochilaVetor, totalThreads, &comparacoes);
+					vetorOrdenado = 1;
+					reordenou = 1;
+					ok = 1;
+				}
+			} else if (strcmp(comando, "manter") == 0) {
+				definirManterOrdenado(&mochilaVetor, strcmp(argumentos, "off") != 0, &vetorOrdenado);
+				reordenou = 1;
+				ok = 1;
+			} else if (strcmp(comando, "hash") == 0) {
+				ok = buscarHashVetor(&mochilaVetor, argumentos, &sondagens) >= 0;
+			} else if (strcmp(comando, "soa") == 0) {
+				ok = sincronizarSoA(&mochilaSoA, &mochilaVetor) && buscarAssinaturaSoA(&mochilaSoA, argumentos, &comparacoes) >= 0;
+			} else if (strcmp(comando, "binaria") == 0) {
+				ok = vetorOrdenado && buscarBinariaVetor(mochilaVetor.itens, mochilaVetor.tamanho, argumentos, &comparacoes) >= 0;
+			} else if (strcmp(comando, "eytzinger") == 0) {
+				ok = vetorOrdenado && sincronizarEytzingerVetor(&mochilaVetor)
+					&& buscarEytzinger(&mochilaVetor.eytzinger, argumentos, &comparacoes) >= 0;
+			} else if (strcmp(comando, "prefixo") == 0 || strcmp(comando, "intervalo") == 0) {
+				FaixaNomes faixa;
+				int inicioFaixa;
+				if (lerFaixaScript(comando, argumentos, &faixa)) {
+					ok = vetorOrdenado && buscarFaixaVetor(mochilaVetor.itens, mochilaVetor.tamanho, faixa, &inicioFaixa, &comparacoes) > 0;
+				}
+			} else {
+				ok = comandoRadixScript(&mochilaVetor.radix, comando, argumentos, &nosRadix);
+			}
+		} else if (strcmp(estrutura, "lista") == 0) {
+			if (strcmp(comando, "inserir") == 0) {
+				char *cursor = argumentos;
+				char *nome = proximoCampo(&cursor);
+				char *tipo = proximoCampo(&cursor);
+				char *qtd = proximoCampo(&cursor);
+				int quantidade;
+				if (nome && tipo && qtd && lerInteiroCampo(qtd, &quantidade) && quantidade > 0) {
+					ok = inserirItemLista(&lista, nome, tipo, quantidade);
+				}
+			} else if (strcmp(comando, "remover") == 0) {
+				ok = removerItemLista(&lista, argumentos);
+			} else if (strcmp(comando, "buscar") == 0) {
+				ok = buscarSequencialLista(lista.inicio, argumentos, &comparacoes) != NULL;
+			} else if (strcmp(comando, "hash") == 0) {
+				ok = buscarHashLista(&lista, argumentos, &sondagens) != NULL;
+			} else if (strcmp(comando, "prefixo") == 0 || strcmp(comando, "intervalo") == 0) {
+				FaixaNomes faixa;
+				if (lerFaixaScript(comando, argumentos, &faixa)) {
+					ok = buscarFaixaLista(lista.inicio, faixa, NULL, 0, &comparacoes) > 0;
+				}
+			} else {
+				ok = comandoRadixScript(&lista.radix, comando, argumentos, &nosRadix);
+			}
+		} else if (strcmp(estrutura, "desenrolada") == 0) {
+			if (strcmp(comando, "inserir") == 0) {
+				char *cursor = argumentos;
+				char *nome = proximoCampo(&cursor);
+				char *tipo = proximoCampo(&cursor);
+				char *qtd = proximoCampo(&cursor);
+				int quantidade;
+				if (nome && tipo && qtd && lerInteiroCampo(qtd, &quantidade) && quantidade > 0) {
+					ok = inserirItemDesenrolada(&desenrolada, nome, tipo, quantidade);
+				}
+			} else if (strcmp(comando, "remover") == 0) {
+				ok = removerItemDesenrolada(&desenrolada, argumentos);
+			} else if (strcmp(comando, "buscar") == 0) {
+				ok = buscarSequencialDesenrolada(&desenrolada, argumentos, &comparacoes, &nosVisitados) != NULL;
+			}
+		} else if (strcmp(estrutura, "torre") == 0) {
+			if (strcmp(comando, "inserir") == 0) {
+				char *cursor = argumentos;
+				char *nome = proximoCampo(&cursor);
+				char *tipo = proximoCampo(&cursor);
+				char *prioridade = proximoCampo(&cursor);
+				int valorPrioridade;
+				if (nome && tipo && prioridade && lerInteiroCampo(prioridade, &valorPrioridade)
+					&& valorPrioridade >= 1 && valorPrioridade <= 10) {
+					ok = adicionarComponente(&torre, nome, tipo, valorPrioridade);
+					ordenadoPorNome = 0;
+				}
+			} else if (strcmp(comando, "ordenar") == 0) {
+				long comparacoesOrdenacao = 0;
+				if (strcmp(argumentos, "nome") == 0) {
+					bubbleSortNome(torre.itens, torre.total, &comparacoesOrdenacao);
+					ordenadoPorNome = 1;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					ok = 1;
+				} else if (strcmp(argumentos, "tipo") == 0) {
+					insertionSortTipo(torre.itens, torre.total, &comparacoesOrdenacao);
+					ordenadoPorNome = 0;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					ok = 1;
+				} else if (strcmp(argumentos, "prioridade") == 0) {
+					selectionSortPrioridade(torre.itens, torre.total, &comparacoesOrdenacao);
+					ordenadoPorNome = 0;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					ok = 1;
+				}
+				comparacoes += comparacoesOrdenacao;
+			} else if (strcmp(comando, "mergesort") == 0) {
+				long comparacoesOrdenacao = 0;
+				if (strcmp(argumentos, "nome") == 0) {
+					mergeSortNome(torre.itens, torre.total, &comparacoesOrdenacao);
+					ordenadoPorNome = 1;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					ok = 1;
+				} else if (strcmp(argumentos, "tipo") == 0) {
+					mergeSortTipo(torre.itens, torre.total, &comparacoesOrdenacao);
+					ordenadoPorNome = 0;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					ok = 1;
+				} else if (strcmp(argumentos, "prioridade") == 0) {
+					mergeSortPrioridade(torre.itens, torre.total, &comparacoesOrdenacao);
+					ordenadoPorNome = 0;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					ok = 1;
+				}
+				comparacoes += comparacoesOrdenacao;
+			} else if (strcmp(comando, "paralelo") == 0) {
+				char *cursor = argumentos;
+				char *criterio = proximoCampo(&cursor);
+				char *threads = proximoCampo(&cursor);
+				ComparadorComponente comparar = !criterio ? NULL
+					: strcmp(criterio, "nome") == 0 ? compararPorNome
+					: strcmp(criterio, "tipo") == 0 ? compararPorTipo
+					: strcmp(criterio, "prioridade") == 0 ? compararPorPrioridade : NULL;
+				int totalThreads = threadsDisponiveis();
+				if (comparar && (!threads || (lerInteiroCampo(threads, &totalThreads) && totalThreads > 0))) {
+					long comparacoesOrdenacao = 0;
+					mergeSortParalelo(torre.itens, torre.total, comparar, totalThreads,
+						&ultimaOrdenacaoParalela, &comparacoesOrdenacao);
+					ordenadoPorNome = comparar == compararPorNome;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					comparacoes += comparacoesOrdenacao;
+					ok = 1;
+				}
+			} else if (strcmp(comando, "contagem") == 0) {
+				long comparacoesOrdenacao = 0;
+				trocasOrdenacao = 0;
+				if (strcmp(argumentos, "prioridade") == 0) {
+					countingSortPrioridade(torre.itens, torre.total, &comparacoesOrdenacao);
+					ok = 1;
+				} else if (strcmp(argumentos, "tipo") == 0) {
+					countingSortTipo(torre.itens, torre.total, &comparacoesOrdenacao);
+					ok = 1;
+				}
+				if (ok > 0) {
+					ordenadoPorNome = 0;
+					invalidarVisoes(&torre);
+					reordenou = 1;
+					movimentos += trocasOrdenacao;
+				}
+				comparacoes += comparacoesOrdenacao;
+			} else if (strcmp(comando, "binaria") == 0) {
+				long comparacoesBusca = 0;
+				if (ordenadoPorNome) {
+					ok = buscaBinariaPorNome(torre.itens, torre.total, argumentos, &comparacoesBusca) >= 0;
+				} else {
+					ok = garantirVisao(&torre, CRITERIO_NOME, &comparacoesBusca);
+					comparacoes += comparacoesBusca;
+					ok = ok && buscaBinariaVisaoNome(&torre, argumentos, &comparacoesBusca) >= 0;
+				}
+				comparacoes += comparacoesBusca;
+			} else if (strcmp(comando, "eytzinger") == 0) {
+				long comparacoesIndice = 0;
+				ok = sincronizarEytzingerTorre(&torre, ordenadoPorNome, &comparacoesIndice)
+					&& buscarEytzinger(&torre.eytzinger, argumentos, &comparacoes) >= 0;
+				comparacoes += comparacoesIndice;
+			} else if (strcmp(comando, "prefixo") == 0 || strcmp(comando, "intervalo") == 0) {
+				FaixaNomes faixa;
+				const int *indicesFaixa;
+				if (lerFaixaScript(comando, argumentos, &faixa)) {
+					ok = buscarFaixaTorre(&torre, faixa, &indicesFaixa, &comparacoes) > 0;
+				}
+			} else if (strcmp(comando, "faixa") == 0) {
+				char *cursor = argumentos;
+				char *tipo = proximoCampo(&cursor);
+				char *prioridade = proximoCampo(&cursor);
+				int prioridadeMinima;
+				if (tipo && prioridade && lerInteiroCampo(prioridade, &prioridadeMinima)
+					&& prioridadeMinima >= 1 && prioridadeMinima <= 10) {
+					const int *faixa;
+					long comparacoesFaixa = 0;
+					ok = consultarTipoPrioridade(&torre, tipo, prioridadeMinima, &faixa, &comparacoesFaixa) > 0;
+					comparacoes += comparacoesFaixa;
+				}
+			} else {
+				ok = comandoRadixScript(&torre.radix, comando, argumentos, &nosRadix);
+			}
+		}
+
+		if (ok < 0) {
+			invalidas++;
+			if (invalidas <= 10) {
+				fprintf(stderr, "Linha %ld: comando invalido\n", numeroLinha);
+			}
+			continue;
+		}
+		operacoes++;
+		if (!ok) {
+			falhas++;
+		}
+		if (caminhoDiario && (reordenou || diario.registrosDesdeCompactacao >= DIARIO_COMPACTAR_APOS)) {
+			compactarDiario(&diario, &mochilaVetor, vetorOrdenado, &lista, &torre, ordenadoPorNome);
+		}
+	}
+	if (caminhoDiario) {
+		fecharDiario(&diario);
+	}
+	double decorrido = tempoMonotonico() - inicio;
+	modoSilencioso = 0;
+	fclose(arquivo);
 
+	printf("=== RESUMO DO SCRIPT %s ===\n", caminho);
+	printf("Operacoes executadas: %ld (sem efeito/nao encontradas: %ld, invalidas: %ld)\n", operacoes, falhas, invalidas);
+	printf("Vetor: %d itens%s | Lista: %d itens | Desenrolada: %d itens em %d nos | Torre: %d componentes%s\n",
+		mochilaVetor.tamanho, vetorOrdenado ? " (ordenado)" : "", lista.tamanho,
+		desenrolada.tamanho, desenrolada.nos,
+		torre.total, ordenadoPorNome ? " (ordenada por nome)" : "");
+	printf("Comparacoes totais: %ld | Sondagens hash: %ld | Nos desenrolados visitados: %ld\n", comparacoes, sondagens, nosVisitados);
+	if (movimentos > 0) {
+		printf("Movimentos do counting sort: %ld\n", movimentos);
+	}
+	if (buscasLote > 0) {
+		printf("Buscas em lote: %ld nomes\n", buscasLote);
+	}
+	if (nosRadix > 0) {
+		printf("Nos radix visitados: %ld | nos ativos: vetor %d, lista %d, torre %d\n", nosRadix,
+			mochilaVetor.radix.totalNos - mochilaVetor.radix.nosLivres, lista.radix.totalNos - lista.radix.nosLivres,
+			torre.radix.totalNos - torre.radix.nosLivres);
+	}
+	if (mochilaVetor.manterOrdenado) {
+		printf("Vetor mantido ordenado: %ld reordenacoes evitadas\n", mochilaVetor.reordenacoesEvitadas);
+	}
+	if (linhasCsv > 0) {
+		printf("Linhas CSV importadas: %ld (rejeitadas: %ld)\n", linhasCsv, rejeitadasCsv);
+	}
+	printf("Tempo: %.6f s | Vazao: %.0f ops/s\n", decorrido, decorrido > 0 ? operacoes / decorrido : 0.0);
+	mostrarEstatisticasPool(&lista.pool);
+	mostrarMemoriaTipos((long)mochilaVetor.tamanho + lista.tamanho + desenrolada.tamanho + torre.total);
+	if (caminhoDiario) {
+		mostrarEstatisticasDiario(&diario);
+	}
 
+	liberarVetor(&mochilaVetor);
+	liberarSoA(&mochilaSoA);
+	liberarLista(&lista);
+	liberarListaDesenrolada(&desenrolada);
+	liberarComponentes(&torre);
+	liberarTabelaTipos();
+	return 0;
+}